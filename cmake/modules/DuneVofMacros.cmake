@@ -0,0 +1,6 @@
+# zlib is optional, it enables compressed VTK output and snapshots
+find_package(ZLIB)
+set(HAVE_ZLIB ${ZLIB_FOUND})
+if(ZLIB_FOUND)
+  dune_register_package_flags(LIBRARIES ${ZLIB_LIBRARIES} INCLUDE_DIRS ${ZLIB_INCLUDE_DIRS})
+endif()
@@ -40,6 +40,9 @@
 /* Define to the revision of dune-vof */
 #define DUNE_VOF_VERSION_REVISION @DUNE_VOF_VERSION_REVISION@
 
+/* Define to 1 if zlib is found */
+#cmakedefine HAVE_ZLIB 1
+
 /* end dune-vof
    Everything below here will be overwritten
 */
@@ -2,19 +2,24 @@
 #define DUNE_VOF_ALGORITHM_HH
 
 // C++ includes
+#include <functional>
 #include <utility>
 
 // dune-common includes
 #include <dune/common/timer.hh>
+#include <dune/common/typeutilities.hh>
 
 // dune-vof includes
 #include "test/errors.hh"
+#include <dune/vof/colorfunction.hh>
+#include <dune/vof/common/threadpartition.hh>
 #include <dune/vof/evolution.hh>
 #include <dune/vof/flagset.hh>
 #include <dune/vof/flagging.hh>
 #include <dune/vof/reconstruction.hh>
 #include <dune/vof/reconstructionset.hh>
 #include <dune/vof/stencil/vertexneighborsstencil.hh>
+#include <dune/vof/timestepcontrol.hh>
 #include <dune/vof/velocity.hh>
 
 namespace Dune
@@ -41,26 +46,59 @@ namespace Dune
       using Problem = PR;
       using DataWriter = DW;
       using Stencils = VertexNeighborsStencil< GridView >;
-      using Reconstructions = ReconstructionSet< GridView >;
+      using Reconstructions = SparseReconstructionSet< GridView >;
       using Flags = FlagSet< GridView >;
       using VelocityField = Velocity< Problem, GridView >;
+      using TimeStepControlType = TimeStepControl< typename GridView::CollectiveCommunication >;
+
+      /**
+       * \brief state of the time iteration after a completed step, sufficient to continue it
+       */
+      struct State
+      {
+        double time = 0.0, dt = 0.0, error = 0.0;
+      };
+
+      using Checkpoint = std::function< void( const State & ) >;
 
       Algorithm ( const GridView &gridView, const Problem& problem, DataWriter& dataWriter, double cfl, double eps, const bool verbose = false )
+       : Algorithm( gridView, problem, dataWriter, cfl, eps, TimeStepControlType( gridView.comm() ), verbose )
+      {}
+
+      /**
+       * \param   threads   number of threads per rank for reconstruction and evolution, \see ThreadPartition
+       */
+      Algorithm ( const GridView &gridView, const Problem& problem, DataWriter& dataWriter, double cfl, double eps,
+                  const TimeStepControlType &timeStepControl, const bool verbose = false, std::size_t threads = 1 )
        : gridView_( gridView ), problem_( problem ), dataWriter_( dataWriter ), cfl_( cfl ), eps_( eps ), verbose_( verbose ),
-         stencils_( gridView ), reconstructions_( gridView ), flags_( gridView )
+         stencils_( gridView ), flags_( gridView ), reconstructions_( flags_ ), timeStepControl_( timeStepControl ),
+         threads_( gridView, threads )
       {}
 
       template< class ColorFunction >
       double operator() ( ColorFunction& uh, double start, double end, int level = 0 )
+      {
+        State state;
+        state.time = start;
+        return (*this)( uh, state, end, level );
+      }
+
+      /**
+       * \brief continue the time iteration from a given state, e.g., restored from a checkpoint
+       */
+      template< class ColorFunction >
+      double operator() ( ColorFunction& uh, State &state, double end, int level = 0 )
       {
         // Create operators
         auto reconstructionOperator = reconstruction( stencils_ );
         auto flagOperator = FlagOperator< GridView >( eps_ );
         auto evolutionOperator = evolution( gridView_ );
 
-        double time = start, dt = 0.0, dtEst = 0.0;
-        double error = 0.0;
-        ColorFunction update( gridView_ );
+        const double start = state.time;
+        double &time = state.time, &dt = state.dt, &error = state.error;
+        double dtEst = 0.0;
+        // fluxes are accumulated in double, whatever the storage type of uh
+        VoF::ColorFunction< GridView, double > update( gridView_ );
 
         Dune::Timer timer( false );
 
@@ -73,12 +111,19 @@ namespace Dune
           VelocityField velocity( problem_, time );
 
           flagOperator( uh, flags_ );
+          reconstructions_.update();
 
           timer.start();
-          reconstructionOperator( uh, reconstructions_, flags_ );
+          if ( threads_.size() > 1 )
+            reconstructionOperator( uh, reconstructions_, flags_, threads_ );
+          else
+            reconstructionOperator( uh, reconstructions_, flags_ );
           timer.stop();
 
-          dtEst = evolutionOperator( reconstructions_, flags_, velocity, dt, update );
+          if ( threads_.size() > 1 )
+            dtEst = evolutionOperator( reconstructions_, flags_, velocity, dt, update, threads_, timeStepControl_ );
+          else
+            dtEst = evolutionOperator( reconstructions_, flags_, velocity, dt, update, timeStepControl_ );
 
           uh.axpy( 1.0, update );
 
@@ -91,12 +136,18 @@ namespace Dune
           dataWriter_.write( time );
 
           dt = dtEst * cfl_;
+
+          if ( checkpoint_ )
+            checkpoint_( state );
         }
         while( time < end );
 
         if ( time == start )
           error += Dune::VoF::l1error( gridView_, reconstructions(), flags(), problem_, time );
 
+        // report errors of snapshots still written in the background
+        flush( dataWriter_, PriorityTag< 1 >() );
+
         if ( gridView_.comm().rank() == 0 )
           std::cout << "Elapsed time for reconstruction: " << timer.elapsed() << "s" << std::endl;
 
@@ -107,16 +158,31 @@ namespace Dune
 
       const Flags& flags() const { return flags_; }
 
+      /**
+       * \brief set a function called with the state after every step
+       */
+      void checkpoint ( Checkpoint checkpoint ) { checkpoint_ = std::move( checkpoint ); }
+
 
     private:
+      // flush data writers that write asynchronously
+      template< class W >
+      static auto flush ( W &dataWriter, PriorityTag< 1 > ) -> decltype( dataWriter.flush() ) { return dataWriter.flush(); }
+
+      template< class W >
+      static void flush ( W &dataWriter, PriorityTag< 0 > ) {}
+
       const GridView& gridView_;
       const Problem& problem_;
       DataWriter& dataWriter_;
       const double cfl_, eps_;
       const bool verbose_;
       const Stencils stencils_;
-      Reconstructions reconstructions_;
       Flags flags_;
+      Reconstructions reconstructions_;
+      TimeStepControlType timeStepControl_;
+      const ThreadPartition< GridView > threads_;
+      Checkpoint checkpoint_;
     };
 
   } // namespace VoF
@@ -1,10 +1,20 @@
 #ifndef COLORFUNCTION_HH
 #define COLORFUNCTION_HH
 
+#include <cstdint>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+//- dune-common includes
+#include <dune/common/exceptions.hh>
+
 //- dune-grid includes
 #include <dune/grid/common/mcmgmapper.hh>
 
 #include <dune/vof/dataset.hh>
+#include <dune/vof/io/blockio.hh>
 
 
 // ColorFunction
@@ -16,19 +26,30 @@ namespace Dune
   namespace VoF
   {
 
-    template< class GV >
+    /**
+     * \ingroup Method
+     * \brief volume fractions of the first phase
+     * \details The storage type may be chosen smaller than the arithmetic type, e.g., float.
+     *          Values are then converted to double on read, so all kernels compute in double
+     *          precision while memory footprint and communication volume are halved.
+     *
+     * \tparam  GV  grid view
+     * \tparam  T   storage type
+     */
+    template< class GV, class T = double >
     struct ColorFunction
-      : public Dune::VoF::DataSet < GV, double >
+      : public Dune::VoF::DataSet < GV, T >
     {
       using GridView = GV;
-      using ThisType = ColorFunction< GridView >;
-      using BaseType = typename Dune::VoF::DataSet< GridView, double >;
+      using ThisType = ColorFunction< GridView, T >;
+      using BaseType = typename Dune::VoF::DataSet< GridView, T >;
       using ctype = double;
 
     public:
       ColorFunction ( const GridView &gridView ) : BaseType( gridView ) {}
 
-      void axpy ( const ctype a, ThisType &x )
+      template< class S >
+      void axpy ( const ctype a, const ColorFunction< GridView, S > &x )
       {
         assert( x.size() == this->size() );
 
@@ -36,19 +57,200 @@ namespace Dune
           this->operator[]( entity ) += a * x[ entity ];
       }
 
+      /**
+       * \brief write values as one contiguous block
+       * \details The header holds the number of values, whether the index set enumerates
+       *          the elements in iteration order and the encoding. If the index set is not in
+       *          iteration order, the index of each element in iteration order follows, so the
+       *          data can be read on a grid with a different index set. Values are always stored
+       *          as double. The ordering is determined on the first write or read and cached.
+       *          The sparse encoding stores runs of empty (exactly 0), mixed and full (exactly 1)
+       *          cells and explicit values for mixed cells only, so its size scales with the
+       *          interface. A positive compression level additionally byte shuffles and zlib
+       *          compresses the value blocks (see writeCompressedBlock). All encodings are
+       *          lossless; read detects the encoding.
+       */
       template< class BinaryInStream >
-      void write ( BinaryInStream &in ) const
+      void write ( BinaryInStream &in, bool sparse = false, int level = 0 ) const
       {
-        for ( const auto &entity : elements( this->gridView() ) )
-          in.writeDouble( this->operator[]( entity ) );
+        const bool ordered = isIndexOrdered();
+
+        const std::uint8_t encoding = ( sparse ? sparseEncoding : 0 ) | ( level > 0 ? compressedEncoding : 0 );
+        in.writeUnsignedInt64( this->size() );
+        in.writeBool( ordered );
+        writeBlock( in, &encoding, 1 );
+        if ( !ordered )
+          writeBlock( in, ordering_.data(), ordering_.size() );
+
+        if ( sparse )
+          writeSparse( in, level );
+        else if ( std::is_same< T, ctype >::value )
+          writeValues( in, &*this->begin(), this->size(), level );
+        else
+        {
+          std::vector< ctype > values( this->begin(), this->end() );
+          writeValues( in, values.data(), values.size(), level );
+        }
       }
 
       template< class BinaryOutStream >
       void read ( BinaryOutStream &out )
       {
+        std::uint64_t size;
+        bool ordered;
+        std::uint8_t encoding;
+        out.readUnsignedInt64( size );
+        out.readBool( ordered );
+        readBlock( out, &encoding, 1 );
+        if ( size != this->size() )
+          DUNE_THROW( IOError, "ColorFunction size " << this->size() << " does not match stored size " << size );
+
+        std::vector< std::uint64_t > ordering;
+        if ( !ordered )
+        {
+          ordering.resize( size );
+          readBlock( out, ordering.data(), ordering.size() );
+        }
+
+        const bool compressed = ( encoding & compressedEncoding );
+        std::vector< ctype > values( size );
+        if ( encoding & sparseEncoding )
+          readSparse( out, values, compressed );
+        else
+          readValues( out, values.data(), values.size(), compressed );
+
+        if ( ordered && isIndexOrdered() )
+          std::copy( values.begin(), values.end(), this->begin() );
+        else
+        {
+          std::size_t i = 0;
+          for ( const auto &entity : elements( this->gridView() ) )
+          {
+            this->operator[]( entity ) = values[ ordered ? i : ordering[ i ] ];
+            ++i;
+          }
+        }
+      }
+
+      // bits of the encoding byte; a dense, uncompressed block is encoded as 0
+      static const std::uint8_t sparseEncoding = 1;
+      static const std::uint8_t compressedEncoding = 2;
+
+    private:
+      // the ordering itself is only kept if the index set is not in iteration order
+      bool isIndexOrdered () const
+      {
+        if ( !orderingCached_ )
+        {
+          ordered_ = isIndexOrdered( ordering_ );
+          if ( ordered_ )
+            std::vector< std::uint64_t >().swap( ordering_ );
+          orderingCached_ = true;
+        }
+        return ordered_;
+      }
+
+      bool isIndexOrdered ( std::vector< std::uint64_t > &ordering ) const
+      {
+        const auto &indexSet = this->gridView().indexSet();
+
+        bool ordered = true;
+        ordering.clear();
+        ordering.reserve( this->size() );
         for ( const auto &entity : elements( this->gridView() ) )
-          out.readDouble( this->operator[]( entity ) );
+        {
+          ordering.push_back( indexSet.index( entity ) );
+          ordered &= ( ordering.back() == ordering.size()-1 );
+        }
+        return ordered;
+      }
+
+      enum State : std::uint8_t { empty = 0, mixed = 1, full = 2 };
+
+      static State state ( ctype value ) { return ( value == 0.0 ? empty : ( value == 1.0 ? full : mixed ) ); }
+
+      template< class BinaryInStream, class V >
+      static void writeValues ( BinaryInStream &in, const V *data, std::size_t n, int level )
+      {
+        if ( level > 0 )
+          writeCompressedBlock( in, data, n, level );
+        else
+          writeBlock( in, data, n );
+      }
+
+      template< class BinaryOutStream, class V >
+      static void readValues ( BinaryOutStream &out, V *data, std::size_t n, bool compressed )
+      {
+        if ( compressed )
+          readCompressedBlock( out, data, n );
+        else
+          readBlock( out, data, n );
       }
+
+      template< class BinaryInStream >
+      void writeSparse ( BinaryInStream &in, int level ) const
+      {
+        std::vector< std::uint8_t > states;
+        std::vector< std::uint64_t > lengths;
+        std::vector< ctype > values;
+        for ( const ctype value : *this )
+        {
+          const State s = state( value );
+          if ( s == mixed )
+            values.push_back( value );
+
+          if ( !states.empty() && states.back() == s )
+            ++lengths.back();
+          else
+          {
+            states.push_back( s );
+            lengths.push_back( 1 );
+          }
+        }
+
+        in.writeUnsignedInt64( states.size() );
+        writeValues( in, states.data(), states.size(), level );
+        writeValues( in, lengths.data(), lengths.size(), level );
+        in.writeUnsignedInt64( values.size() );
+        writeValues( in, values.data(), values.size(), level );
+      }
+
+      template< class BinaryOutStream >
+      static void readSparse ( BinaryOutStream &out, std::vector< ctype > &values, bool compressed )
+      {
+        std::uint64_t runs, mixedCells;
+        out.readUnsignedInt64( runs );
+        std::vector< std::uint8_t > states( runs );
+        std::vector< std::uint64_t > lengths( runs );
+        readValues( out, states.data(), states.size(), compressed );
+        readValues( out, lengths.data(), lengths.size(), compressed );
+        out.readUnsignedInt64( mixedCells );
+        std::vector< ctype > mixedValues( mixedCells );
+        readValues( out, mixedValues.data(), mixedValues.size(), compressed );
+
+        auto value = values.begin();
+        auto mixedValue = mixedValues.begin();
+        for ( std::size_t r = 0; r < runs; ++r )
+        {
+          if ( static_cast< std::uint64_t >( values.end() - value ) < lengths[ r ] )
+            DUNE_THROW( IOError, "Corrupt sparse ColorFunction block" );
+
+          if ( states[ r ] == mixed )
+          {
+            if ( static_cast< std::uint64_t >( mixedValues.end() - mixedValue ) < lengths[ r ] )
+              DUNE_THROW( IOError, "Corrupt sparse ColorFunction block" );
+            value = std::copy_n( mixedValue, lengths[ r ], value );
+            mixedValue += lengths[ r ];
+          }
+          else
+            value = std::fill_n( value, lengths[ r ], ( states[ r ] == full ? 1.0 : 0.0 ) );
+        }
+        if ( value != values.end() )
+          DUNE_THROW( IOError, "Corrupt sparse ColorFunction block" );
+      }
+
+      mutable bool orderingCached_ = false, ordered_ = false;
+      mutable std::vector< std::uint64_t > ordering_;
     };
 
   } // namespace VoF
@@ -0,0 +1,40 @@
+#ifndef DUNE_VOF_COMMON_MPITRAITS_HH
+#define DUNE_VOF_COMMON_MPITRAITS_HH
+
+#include <type_traits>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif // #if HAVE_MPI
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // IsMPICommunication
+    // ------------------
+
+    /**
+     * \ingroup Other
+     * \brief true if a collective communication wraps an MPI communicator
+     *
+     * \tparam  Comm  collective communication type
+     */
+    template< class Comm, class = void >
+    struct IsMPICommunication
+      : public std::false_type
+    {};
+
+#if HAVE_MPI
+    template< class Comm >
+    struct IsMPICommunication< Comm, std::enable_if_t< std::is_convertible< Comm, MPI_Comm >::value > >
+      : public std::true_type
+    {};
+#endif // #if HAVE_MPI
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_COMMON_MPITRAITS_HH
@@ -0,0 +1,319 @@
+#ifndef DUNE_VOF_COMMON_PERSISTENTEXCHANGE_HH
+#define DUNE_VOF_COMMON_PERSISTENTEXCHANGE_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif // #if HAVE_MPI
+
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+
+#include <dune/vof/common/mpitraits.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // CommunicationPlan
+    // -----------------
+
+    /**
+     * \ingroup Other
+     * \brief communication pattern of codimension 0 data on a grid view
+     * \details The pattern is detected once by sending indices through the grid's communication.
+     *          For each neighboring rank it holds the local indices to send and to receive in
+     *          matching order.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    struct CommunicationPlan
+    {
+      using GridView = GV;
+      using Index = typename GridView::IndexSet::IndexType;
+
+      struct Link
+      {
+        int rank;
+        std::vector< Index > send, recv;
+      };
+
+    private:
+      // pairs of ( index on sending rank, index on receiving rank ) for each neighbor
+      using Pairs = std::map< int, std::vector< std::pair< Index, Index > > >;
+
+      struct Discovery;
+
+    public:
+      CommunicationPlan ( const GridView &gridView, Dune::InterfaceType interface )
+      {
+        Pairs send, recv;
+
+        Discovery forward( gridView, recv, true );
+        gridView.communicate( forward, interface, Dune::ForwardCommunication );
+
+        Discovery backward( gridView, send, false );
+        gridView.communicate( backward, interface, Dune::BackwardCommunication );
+
+        for( auto &s : send )
+          link( s.first ).send = order( s.second, true );
+        for( auto &r : recv )
+          link( r.first ).recv = order( r.second, false );
+      }
+
+      const std::vector< Link > &links () const { return links_; }
+
+    private:
+      Link &link ( int rank )
+      {
+        auto it = std::find_if( links_.begin(), links_.end(), [ rank ] ( const Link &l ) { return l.rank == rank; } );
+        if( it != links_.end() )
+          return *it;
+        links_.push_back( Link{ rank, {}, {} } );
+        return links_.back();
+      }
+
+      static std::vector< Index > order ( std::vector< std::pair< Index, Index > > &pairs, bool sender )
+      {
+        std::sort( pairs.begin(), pairs.end() );
+        std::vector< Index > indices;
+        indices.reserve( pairs.size() );
+        for( const auto &p : pairs )
+          indices.push_back( sender ? p.first : p.second );
+        return indices;
+      }
+
+      std::vector< Link > links_;
+    };
+
+
+
+    // Discovery data handle for CommunicationPlan
+    template< class GV >
+    struct CommunicationPlan< GV >::Discovery
+      : public Dune::CommDataHandleIF< Discovery, std::pair< int, Index > >
+    {
+      using Message = std::pair< int, Index >;
+
+      Discovery ( const GridView &gridView, Pairs &pairs, bool forward )
+        : gridView_( gridView ), pairs_( pairs ), rank_( gridView.comm().rank() ), forward_( forward )
+      {}
+
+      bool contains ( int dim, int codim ) const { return ( codim == 0 ); }
+
+      bool fixedsize ( int dim, int codim ) const { return true; }
+
+      template< class Entity >
+      std::size_t size ( const Entity &e ) const { return 1; }
+
+      template< class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension == 0, int > = 0 >
+      void gather ( MessageBuffer &buff, const Entity &e ) const
+      {
+        buff.write( Message( rank_, gridView_.indexSet().index( e ) ) );
+      }
+
+      template< class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension != 0, int > = 0 >
+      void gather ( MessageBuffer &buff, const Entity &e ) const
+      {}
+
+      template< class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension == 0, int > = 0 >
+      void scatter ( MessageBuffer &buff, const Entity &e, std::size_t n )
+      {
+        Message m;
+        buff.read( m );
+        const Index index = gridView_.indexSet().index( e );
+        if( forward_ )
+          pairs_[ m.first ].emplace_back( m.second, index );
+        else
+          pairs_[ m.first ].emplace_back( index, m.second );
+      }
+
+      template< class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension != 0, int > = 0 >
+      void scatter ( MessageBuffer &buff, const Entity &e, std::size_t n )
+      {}
+
+    private:
+      const GridView &gridView_;
+      Pairs &pairs_;
+      int rank_;
+      bool forward_;
+    };
+
+
+
+    // PersistentExchange
+    // ------------------
+
+#if HAVE_MPI
+    /**
+     * \ingroup Other
+     * \brief forward communication of codimension 0 data with buffers and MPI requests set up once
+     * \details The message buffers are allocated for the pattern of a CommunicationPlan and
+     *          registered with persistent MPI requests. Each exchange only packs, starts the
+     *          requests and unpacks. The plan may be shared, the buffers and requests may not.
+     *
+     * \tparam  GV  grid view
+     * \tparam  T   data type (copied bytewise)
+     */
+    template< class GV, class T >
+    class PersistentExchange
+    {
+      using This = PersistentExchange< GV, T >;
+
+    public:
+      using GridView = GV;
+      using DataType = T;
+      using Plan = CommunicationPlan< GridView >;
+
+      PersistentExchange ( const GridView &gridView, Dune::InterfaceType interface )
+        : PersistentExchange( gridView, std::make_shared< const Plan >( gridView, interface ) )
+      {}
+
+      PersistentExchange ( const GridView &gridView, std::shared_ptr< const Plan > plan )
+        : plan_( std::move( plan ) ),
+          sendBuffers_( plan_->links().size() ),
+          recvBuffers_( plan_->links().size() )
+      {
+        MPI_Comm comm = gridView.comm();
+        for( std::size_t l = 0; l < plan_->links().size(); ++l )
+        {
+          const auto &link = plan_->links()[ l ];
+          if( !link.send.empty() )
+          {
+            sendBuffers_[ l ].resize( link.send.size() );
+            requests_.emplace_back();
+            MPI_Send_init( sendBuffers_[ l ].data(), bytes( link.send.size() ), MPI_BYTE, link.rank, tag, comm, &requests_.back() );
+          }
+          if( !link.recv.empty() )
+          {
+            recvBuffers_[ l ].resize( link.recv.size() );
+            requests_.emplace_back();
+            MPI_Recv_init( recvBuffers_[ l ].data(), bytes( link.recv.size() ), MPI_BYTE, link.rank, tag, comm, &requests_.back() );
+          }
+        }
+      }
+
+      PersistentExchange ( const This & ) = delete;
+      This &operator= ( const This & ) = delete;
+
+      ~PersistentExchange ()
+      {
+        for( auto &request : requests_ )
+          MPI_Request_free( &request );
+      }
+
+      template< class DataSet, class Reduce >
+      void operator() ( DataSet &dataSet, const Reduce &reduce )
+      {
+        exchange( [ &dataSet ] ( const auto &index ) { return dataSet[ index ]; },
+                  [ &dataSet, &reduce ] ( const auto &index, const DataType &x ) {
+                    DataType &y = dataSet[ index ];
+                    y = reduce( x, y );
+                  } );
+      }
+
+      /**
+       * \brief exchange with gather( index ) returning the value to send for an index of the grid
+       *        view and scatter( index, value ) storing a received value
+       */
+      template< class Gather, class Scatter >
+      void exchange ( Gather &&gather, Scatter &&scatter )
+      {
+        const auto &links = plan_->links();
+
+        for( std::size_t l = 0; l < links.size(); ++l )
+          std::transform( links[ l ].send.begin(), links[ l ].send.end(), sendBuffers_[ l ].begin(), gather );
+
+        MPI_Startall( requests_.size(), requests_.data() );
+        MPI_Waitall( requests_.size(), requests_.data(), MPI_STATUSES_IGNORE );
+
+        for( std::size_t l = 0; l < links.size(); ++l )
+          for( std::size_t i = 0; i < links[ l ].recv.size(); ++i )
+            scatter( links[ l ].recv[ i ], recvBuffers_[ l ][ i ] );
+      }
+
+      const std::shared_ptr< const Plan > &plan () const { return plan_; }
+
+    private:
+      static int bytes ( std::size_t count ) { return static_cast< int >( count * sizeof( DataType ) ); }
+
+      static const int tag = 565;
+
+      std::shared_ptr< const Plan > plan_;
+      std::vector< std::vector< DataType > > sendBuffers_, recvBuffers_;
+      std::vector< MPI_Request > requests_;
+    };
+
+
+
+    // PersistentExchanges
+    // -------------------
+
+    /**
+     * \ingroup Other
+     * \brief persistent exchanges of one container, one per communication interface
+     * \details Exchanges are set up on first use of an interface. Copies share the communication
+     *          plans, which only depend on the grid view, but set up buffers and requests of
+     *          their own, so copies never communicate through the same memory.
+     *
+     * \tparam  GV  grid view
+     * \tparam  T   data type (copied bytewise)
+     */
+    template< class GV, class T >
+    class PersistentExchanges
+    {
+      using This = PersistentExchanges< GV, T >;
+
+    public:
+      using GridView = GV;
+      using Exchange = PersistentExchange< GV, T >;
+      using Plan = typename Exchange::Plan;
+
+      PersistentExchanges () = default;
+
+      PersistentExchanges ( const This &other ) : plans_( other.plans_ ) {}
+
+      This &operator= ( const This &other )
+      {
+        plans_ = other.plans_;
+        for( auto &exchange : exchanges_ )
+          exchange.reset();
+        return *this;
+      }
+
+      Exchange &operator() ( const GridView &gridView, Dune::InterfaceType interface )
+      {
+        const std::size_t i = static_cast< std::size_t >( interface );
+        assert( i < exchanges_.size() );
+        if( !exchanges_[ i ] )
+        {
+          if( !plans_[ i ] )
+            plans_[ i ] = std::make_shared< const Plan >( gridView, interface );
+          exchanges_[ i ].reset( new Exchange( gridView, plans_[ i ] ) );
+        }
+        return *exchanges_[ i ];
+      }
+
+    private:
+      std::array< std::shared_ptr< const Plan >, 5 > plans_;
+      std::array< std::unique_ptr< Exchange >, 5 > exchanges_;
+    };
+#endif // #if HAVE_MPI
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_COMMON_PERSISTENTEXCHANGE_HH
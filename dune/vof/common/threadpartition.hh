@@ -0,0 +1,160 @@
+#ifndef DUNE_VOF_COMMON_THREADPARTITION_HH
+#define DUNE_VOF_COMMON_THREADPARTITION_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // ThreadPartition
+    // ---------------
+
+    /**
+     * \ingroup Other
+     * \brief split of the interior and border elements into contiguous chunks, one per thread
+     * \details forEach runs the first chunk on the calling thread and the others on worker
+     *          threads and returns once all chunks are done. The worker threads are started on
+     *          construction and wait for the next call in between, so a call does not pay for
+     *          creating threads; forEach must not be called from a kernel. Worker threads must
+     *          not call MPI; all communication is left to the calling thread
+     *          (MPI_THREAD_FUNNELED).
+     *          Kernels executed in parallel may read any entry of a DataSet, but may only write
+     *          entries of the element they are called for or thread-local storage.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class ThreadPartition
+    {
+    public:
+      using GridView = GV;
+      using Entity = typename GridView::template Codim< 0 >::Entity;
+
+      ThreadPartition ( const GridView &gridView, std::size_t threads )
+        : threads_( std::max( threads, std::size_t( 1 ) ) )
+      {
+        for( const auto &entity : elements( gridView, Partitions::interiorBorder ) )
+          entities_.push_back( entity );
+
+        workers_.reserve( size()-1 );
+        for( std::size_t t = 1; t < size(); ++t )
+          workers_.emplace_back( [ this, t ] () { run( t ); } );
+      }
+
+      ThreadPartition ( const ThreadPartition & ) = delete;
+      ThreadPartition &operator= ( const ThreadPartition & ) = delete;
+
+      ~ThreadPartition ()
+      {
+        {
+          std::lock_guard< std::mutex > lock( mutex_ );
+          finished_ = true;
+        }
+        started_.notify_all();
+        for( auto &worker : workers_ )
+          worker.join();
+      }
+
+      std::size_t size () const { return threads_; }
+
+      /**
+       * \brief apply f( thread, entity ) to all interior and border elements
+       */
+      template< class F >
+      void forEach ( F &&f ) const
+      {
+        std::vector< std::exception_ptr > exceptions( size() );
+        const Job job = [ this, &f, &exceptions ] ( std::size_t t ) { apply( f, t, exceptions[ t ] ); };
+
+        {
+          std::lock_guard< std::mutex > lock( mutex_ );
+          job_ = &job;
+          pending_ = size()-1;
+          ++generation_;
+        }
+        started_.notify_all();
+
+        job( 0 );
+
+        {
+          std::unique_lock< std::mutex > lock( mutex_ );
+          done_.wait( lock, [ this ] () { return pending_ == 0; } );
+          job_ = nullptr;
+        }
+
+        for( const auto &exception : exceptions )
+          if( exception )
+            std::rethrow_exception( exception );
+      }
+
+    private:
+      using Job = std::function< void( std::size_t ) >;
+
+      // worker thread t runs its chunk of each job
+      void run ( std::size_t t )
+      {
+        std::size_t generation = 0;
+        std::unique_lock< std::mutex > lock( mutex_ );
+        while( true )
+        {
+          started_.wait( lock, [ this, &generation ] () { return finished_ || (generation_ != generation); } );
+          if( finished_ )
+            return;
+
+          generation = generation_;
+          const Job &job = *job_;
+          lock.unlock();
+          job( t );
+          lock.lock();
+          if( --pending_ == 0 )
+            done_.notify_one();
+        }
+      }
+
+      template< class F >
+      void apply ( F &f, std::size_t t, std::exception_ptr &exception ) const
+      {
+        try
+        {
+          const std::size_t begin = ( entities_.size() * t ) / size();
+          const std::size_t end = ( entities_.size() * (t+1) ) / size();
+          for( std::size_t i = begin; i < end; ++i )
+            f( t, entities_[ i ] );
+        }
+        catch( ... )
+        {
+          exception = std::current_exception();
+        }
+      }
+
+      std::size_t threads_;
+      std::vector< Entity > entities_;
+
+      std::vector< std::thread > workers_;
+      mutable std::mutex mutex_;
+      mutable std::condition_variable started_, done_;
+      mutable const Job *job_ = nullptr;
+      mutable std::size_t pending_ = 0, generation_ = 0;
+      bool finished_ = false;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_COMMON_THREADPARTITION_HH
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <utility>
 
 //- dune-vof includes
@@ -46,14 +47,25 @@ namespace Dune
       using Heights = Dune::FieldVector< double, Stencil::noc >;
       using Orientation = std::tuple< int, int >;
 
+      using Columns = typename BaseType::Columns;
+
     public:
-      explicit CartesianHeightFunctionCurvature ( const StencilSet &vertexNeighborStencils )
-        : BaseType( vertexNeighborStencils ) {}
+      /**
+       * \brief constructor
+       * \details If the height columns of a HeightFunctionReconstruction are passed, they are
+       *          used without being updated, so the reconstruction must have been applied to
+       *          the same color function right before.
+       */
+      explicit CartesianHeightFunctionCurvature ( const StencilSet &vertexNeighborStencils, std::shared_ptr< Columns > columns = nullptr )
+        : BaseType( vertexNeighborStencils, columns ), sharedColumns_( static_cast< bool >( columns ) ) {}
 
       template< class ColorFunction, class ReconstructionSet, class Flags, class CurvatureSet >
       void operator() ( const ColorFunction &color, const ReconstructionSet &reconstructions, const Flags &flags,
                         CurvatureSet &curvature, bool communicate = true ) const
       {
+        if ( !sharedColumns_ )
+          this->columns()->update( color );
+
         for ( const auto& entity : elements( color.gridView(), Partitions::interiorBorder ) )
         {
           curvature[ entity ] = 0.0;
@@ -185,6 +197,8 @@ namespace Dune
         if ( n > 0 )
           newCurvature[ entity ] /= static_cast< double >( n );
       }
+
+      bool sharedColumns_;
     };
 
   } // namespace VoF
@@ -2,11 +2,14 @@
 #define DUNE_VOF_DATASET__HH
 
 #include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #include <dune/grid/common/gridenums.hh>
 #include <dune/grid/common/datahandleif.hh>
 
+#include <dune/vof/common/persistentexchange.hh>
+
 namespace Dune
 {
   namespace VoF
@@ -66,21 +69,43 @@ namespace Dune
 
       const GridView &gridView () const { return gridView_; }
 
+      /**
+       * \brief forward communication on the given interface
+       * \details If MPI is available, the communication pattern and message buffers of each
+       *          interface are set up on first use and reused afterwards. The grid view is
+       *          assumed not to change during the lifetime of the data set. Copies share the
+       *          communication pattern, but not the buffers (see PersistentExchanges).
+       */
       template< class Reduce >
       void communicate ( Dune::InterfaceType interface, Reduce reduce )
       {
-        auto exchange = Exchange< Reduce > ( *this, std::move( reduce ) );
-        gridView_.communicate( exchange, interface, Dune::ForwardCommunication );
+        communicate( interface, std::move( reduce ), IsMPICommunication< typename GridView::CollectiveCommunication >() );
       }
 
       void communicate ()
       {
         auto reduce = [] ( DataType a, DataType b ) { return a; };
-        auto exchange = Exchange< decltype( reduce ) > ( *this, std::move( reduce ) );
-        gridView_.communicate( exchange, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication );
+        communicate( Dune::InteriorBorder_All_Interface, std::move( reduce ) );
       }
 
     private:
+      template< class Reduce >
+      void communicate ( Dune::InterfaceType interface, Reduce reduce, std::false_type )
+      {
+        auto exchange = Exchange< Reduce > ( *this, std::move( reduce ) );
+        gridView_.communicate( exchange, interface, Dune::ForwardCommunication );
+      }
+
+#if HAVE_MPI
+      template< class Reduce >
+      void communicate ( Dune::InterfaceType interface, Reduce reduce, std::true_type )
+      {
+        exchanges_( gridView_, interface )( *this, reduce );
+      }
+
+      PersistentExchanges< GridView, DataType > exchanges_;
+#endif // #if HAVE_MPI
+
       const IndexSet &indexSet () const { return gridView_.indexSet(); }
       GridView gridView_;
       std::vector< DataType > dataSet_;
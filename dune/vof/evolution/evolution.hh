@@ -1,8 +1,11 @@
 #ifndef DUNE_VOF_EVOLUTION_EVOLUTION_HH
 #define DUNE_VOF_EVOLUTION_EVOLUTION_HH
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <type_traits>
+#include <vector>
 
 //- dune-common includes
 #include <dune/common/fvector.hh>
@@ -12,7 +15,9 @@
 #include <dune/grid/common/partitionset.hh>
 
 //- local includes
+#include <dune/vof/dataset.hh>
 #include <dune/vof/common/commoperation.hh>
+#include <dune/vof/common/threadpartition.hh>
 #include <dune/vof/geometry/intersect.hh>
 #include <dune/vof/geometry/upwindpolygon.hh>
 #include <dune/vof/geometry/utility.hh>
@@ -53,9 +58,25 @@ namespace Dune
        * \param   velocity        velocity
        * \param   deltaT          delta t
        * \param   update          discrete function of flow
+       * \return  global minimum of the time step estimates
        */
       template< class ReconstructionSet, class Flags, class Velocity, class DiscreteFunction >
       double operator() ( const ReconstructionSet& reconstructions, const Flags& flags, Velocity& velocity, double deltaT, DiscreteFunction &update ) const
+      {
+        return gridView().comm().min( (*this)( reconstructions, flags, velocity, deltaT, update, [] ( double dtEst ) { return dtEst; } ) );
+      }
+
+      /**
+       * \brief (gobal) operator application
+       *
+       * \param   velocity        velocity
+       * \param   deltaT          delta t
+       * \param   update          discrete function of flow
+       * \param   timeStepControl reduction of the local time step estimate, \see TimeStepControl
+       */
+      template< class ReconstructionSet, class Flags, class Velocity, class DiscreteFunction, class Control >
+      double operator() ( const ReconstructionSet& reconstructions, const Flags& flags, Velocity& velocity, double deltaT, DiscreteFunction &update,
+                          Control &&timeStepControl ) const
       {
         double dtEst = std::numeric_limits< double >::max();
 
@@ -72,7 +93,52 @@ namespace Dune
 
         update.communicate( Dune::All_All_Interface, CommOperation::Add() );
 
-        return gridView().comm().min( dtEst );
+        return timeStepControl( dtEst );
+      }
+
+      /**
+       * \brief (gobal) operator application on several threads
+       * \details Fluxes are also added to neighbors, so every worker thread collects its
+       *          contributions in a buffer of its own, which are summed up afterwards. The
+       *          velocity is copied for each thread. \see ThreadPartition
+       *
+       * \param   velocity        velocity
+       * \param   deltaT          delta t
+       * \param   update          discrete function of flow
+       * \param   threads         partition of the elements into threads
+       * \param   timeStepControl reduction of the local time step estimate, \see TimeStepControl
+       */
+      template< class ReconstructionSet, class Flags, class Velocity, class DiscreteFunction, class Control >
+      double operator() ( const ReconstructionSet& reconstructions, const Flags& flags, Velocity& velocity, double deltaT, DiscreteFunction &update,
+                          const ThreadPartition< GridView > &threads, Control &&timeStepControl ) const
+      {
+        std::vector< double > dtEst( threads.size(), std::numeric_limits< double >::max() );
+        std::vector< Velocity > velocities( threads.size(), velocity );
+
+        update.clear();
+        while ( buffers_.size() + 1 < threads.size() )
+          buffers_.emplace_back( gridView() );
+
+        threads.forEach( [ this, &reconstructions, &flags, &velocities, deltaT, &update, &dtEst ] ( std::size_t t, const Entity &entity ) {
+            if( !flags.isMixed( entity ) )
+              return;
+
+            using std::min;
+            if ( t == 0 )
+              dtEst[ t ] = min( dtEst[ t ], applyLocal( entity, reconstructions, flags, velocities[ t ], deltaT, update ) );
+            else
+              dtEst[ t ] = min( dtEst[ t ], applyLocal( entity, reconstructions, flags, velocities[ t ], deltaT, buffers_[ t-1 ] ) );
+          } );
+
+        for ( std::size_t t = 1; t < threads.size(); ++t )
+        {
+          std::transform( update.begin(), update.end(), buffers_[ t-1 ].begin(), update.begin(), std::plus< double >() );
+          buffers_[ t-1 ].clear();
+        }
+
+        update.communicate( Dune::All_All_Interface, CommOperation::Add() );
+
+        return timeStepControl( *std::min_element( dtEst.begin(), dtEst.end() ) );
       }
 
     private:
@@ -176,6 +242,7 @@ namespace Dune
       const GridView& gridView() const { return gridView_; }
 
       GridView gridView_;
+      mutable std::vector< DataSet< GridView, double > > buffers_;
     };
 
   } // namespace VoF
@@ -3,6 +3,8 @@
 
 #include <cassert>
 
+#include <type_traits>
+
 #include <dune/common/deprecated.hh>
 
 #include <dune/vof/geometry/utility.hh>
@@ -54,6 +56,22 @@ namespace Dune
        : innerNormal_( normal ), distanceToOrigin_( -1.0*( normal * point ) )
       {}
 
+      /**
+       * \brief convert from half space with different field type (e.g., float storage)
+       */
+      template< class OtherCoord, std::enable_if_t< !std::is_same< OtherCoord, Coordinate >::value && OtherCoord::dimension == Coordinate::dimension, int > = 0 >
+      explicit HalfSpace ( const HalfSpace< OtherCoord > &other )
+       : innerNormal_( other.innerNormal() ), distanceToOrigin_( other.distance() )
+      {}
+
+      template< class OtherCoord, std::enable_if_t< !std::is_same< OtherCoord, Coordinate >::value && OtherCoord::dimension == Coordinate::dimension, int > = 0 >
+      HalfSpace &operator= ( const HalfSpace< OtherCoord > &other )
+      {
+        innerNormal_ = Coordinate( other.innerNormal() );
+        distanceToOrigin_ = other.distance();
+        return *this;
+      }
+
       HalfSpace ( const std::vector< Coordinate > &points )
       {
         assert( points.size() == dimension );
@@ -73,6 +91,11 @@ namespace Dune
        */
       const Coordinate& innerNormal () const { return innerNormal_; }
 
+      /**
+       * \brief signed distance of the bounding plane to the origin
+       */
+      ctype distance () const { return distanceToOrigin_; }
+
       /**
        * \brief bounding hyperplane
        */
@@ -1,8 +1,13 @@
 #ifndef DUNE_VOF_INTERFACEGRID_DATAHANDLE_HH
 #define DUNE_VOF_INTERFACEGRID_DATAHANDLE_HH
 
+#include <cstddef>
+
+#include <algorithm>
+#include <limits>
 #include <type_traits>
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/hybridutilities.hh>
 
 #include <dune/grid/common/datahandleif.hh>
@@ -19,6 +24,16 @@ namespace Dune
     // InterfaceGridDataHandle
     // -----------------------
 
+    /**
+     * \brief data handle communicating interface grid data through the host grid
+     * \details All data of an interface element and its subentities is attached to the host
+     *          element. If the wrapped handle only contains elements and has a fixed size, every
+     *          host element carries that many objects (default constructed ones for host elements
+     *          not on the interface), so the host grid can skip the size communication. Otherwise,
+     *          the number of objects of each subentity with variable size is sent in front of its
+     *          data, which requires an arithmetic DataType able to represent that number exactly;
+     *          sizes of subentities with fixed size are computed on the receiving side.
+     */
     template< class Grid, class WrappedHandle >
     class InterfaceGridDataHandle
       : public CommDataHandleIF< InterfaceGridDataHandle< Grid, WrappedHandle >, typename WrappedHandle::DataType >
@@ -36,10 +51,32 @@ namespace Dune
 
       typedef Dune::Entity< 0, dimension, const Grid, InterfaceGridEntity > Element;
 
-      InterfaceGridDataHandle ( const DataSet &dataSet, WrappedHandle &wrappedHandle )
-        : dataSet_( dataSet ), wrappedHandle_( wrappedHandle )
+      /**
+       * \brief constructor
+       * \details elementSize is the number of objects per element on the fixed-size path (see
+       *          elementsOnly); it must agree on all ranks, also those without interface elements.
+       */
+      InterfaceGridDataHandle ( const DataSet &dataSet, WrappedHandle &wrappedHandle, std::size_t elementSize )
+        : dataSet_( dataSet ), wrappedHandle_( wrappedHandle ), fixedSize_( elementsOnly( wrappedHandle ) ), elementSize_( elementSize )
       {}
 
+      /** \brief whether the wrapped handle only contains elements and has a fixed size */
+      static bool elementsOnly ( const WrappedHandle &wrappedHandle )
+      {
+        bool elementsOnly = wrappedHandle.contains( dimension, 0 ) && wrappedHandle.fixedsize( dimension, 0 );
+        for( int codim = 1; codim <= dimension; ++codim )
+          elementsOnly &= !wrappedHandle.contains( dimension, codim );
+        return elementsOnly;
+      }
+
+      /** \brief number of objects per element on this rank, zero without interface elements */
+      static std::size_t elementSize ( const DataSet &dataSet, const WrappedHandle &wrappedHandle )
+      {
+        if( dataSet.seeds().empty() )
+          return 0;
+        return wrappedHandle.size( element( dataSet, dataSet.gridView().grid().entity( dataSet.seeds().front() ) ) );
+      }
+
       InterfaceGridDataHandle ( const This & ) = delete;
       InterfaceGridDataHandle ( This && ) = delete;
 
@@ -48,19 +85,25 @@ namespace Dune
 
       bool contains ( int dim, int codim ) const { return (codim == 0); }
 
-      bool fixedsize ( int dim, int codim ) const { return false; }
+      bool fixedsize ( int dim, int codim ) const { return fixedSize_; }
 
       template< class HostEntity, std::enable_if_t< (HostEntity::codimension == 0), int > = 0 >
       std::size_t size ( const HostEntity &hostEntity ) const
       {
-        Element element( InterfaceGridEntity< 0, dimension, const Grid >( dataSet(), hostEntity ) );
+        if( fixedSize_ )
+          return elementSize_;
+        if( !dataSet().flags().isMixed( hostEntity ) )
+          return 0;
+
+        const Element element = this->element( hostEntity );
         std::size_t size = 0;
         Hybrid::forEach( std::make_integer_sequence< int, dimension+1 >(), [ this, &element, &size ] ( auto codim ) {
-            if( wrappedHandle_.contains( element.dimension, codim ) )
-            {
-              for( unsigned int i = 0; i < element.subEntities( codim ); ++i )
-                size += wrappedHandle_.size( element.template subEntity< codim >( i ) );
-            }
+            if( !wrappedHandle_.contains( dimension, codim ) )
+              return;
+
+            const bool fixed = wrappedHandle_.fixedsize( dimension, codim );
+            for( unsigned int i = 0; i < element.subEntities( codim ); ++i )
+              size += wrappedHandle_.size( element.template subEntity< codim >( i ) ) + (fixed ? 0 : 1);
           } );
         return size;
       }
@@ -74,12 +117,28 @@ namespace Dune
       template< class MessageBuffer, class HostEntity, std::enable_if_t< (HostEntity::codimension == 0), int > = 0 >
       void gather ( MessageBuffer &buffer, const HostEntity &hostEntity ) const
       {
-        Element element( InterfaceGridEntity< 0, dimension, const Grid >( dataSet(), hostEntity ) );
+        if( !dataSet().flags().isMixed( hostEntity ) )
+        {
+          for( std::size_t i = 0; i < size( hostEntity ); ++i )
+            buffer.write( DataType() );
+          return;
+        }
+
+        const Element element = this->element( hostEntity );
+        if( fixedSize_ )
+          return wrappedHandle_.gather( buffer, element );
+
         Hybrid::forEach( std::make_integer_sequence< int, dimension+1 >(), [ this, &buffer, &element ] ( auto codim ) {
-            if( wrappedHandle_.contains( element.dimension, codim ) )
+            if( !wrappedHandle_.contains( dimension, codim ) )
+              return;
+
+            const bool fixed = wrappedHandle_.fixedsize( dimension, codim );
+            for( unsigned int i = 0; i < element.subEntities( codim ); ++i )
             {
-              for( unsigned int i = 0; i < element.subEntities( codim ); ++i )
-                wrappedHandle_.gather( buffer, element.template subEntity< codim >( i ) );
+              const auto subEntity = element.template subEntity< codim >( i );
+              if( !fixed )
+                writeSize( buffer, wrappedHandle_.size( subEntity ), std::is_arithmetic< DataType >() );
+              wrappedHandle_.gather( buffer, subEntity );
             }
           } );
       }
@@ -91,18 +150,28 @@ namespace Dune
       template< class MessageBuffer, class HostEntity, std::enable_if_t< (HostEntity::codimension == 0), int > = 0 >
       void scatter ( MessageBuffer &buffer, const HostEntity &hostEntity, std::size_t size )
       {
-        Element element( InterfaceGridEntity< 0, dimension, const Grid >( dataSet(), hostEntity ) );
-        Hybrid::forEach( std::make_integer_sequence< int, dimension+1 >(), [ this, &buffer, &element, size ] ( auto codim ) {
-            if( wrappedHandle_.contains( element.dimension, codim ) )
+        if( !dataSet().flags().isMixed( hostEntity ) )
+        {
+          DataType value;
+          for( std::size_t i = 0; i < size; ++i )
+            buffer.read( value );
+          return;
+        }
+
+        const Element element = this->element( hostEntity );
+        if( fixedSize_ )
+          return wrappedHandle_.scatter( buffer, element, size );
+
+        Hybrid::forEach( std::make_integer_sequence< int, dimension+1 >(), [ this, &buffer, &element ] ( auto codim ) {
+            if( !wrappedHandle_.contains( dimension, codim ) )
+              return;
+
+            const bool fixed = wrappedHandle_.fixedsize( dimension, codim );
+            for( unsigned int i = 0; i < element.subEntities( codim ); ++i )
             {
-              // Bug:  We pass the same size to all elements, which is obviously wrong.
-              //       Unfortunately, this cannot be helped, because we can only transfer
-              //       objects of type "DataType", i.e., we cannot additionally transfer
-              //       individual sizes.
-              // Note: Usually, we will only transfer element data on InterfaceGrid, so this
-              //       bug is not an issue.
-              for( unsigned int i = 0; i < element.subEntities( codim ); ++i )
-                wrappedHandle_.scatter( buffer, element.template subEntity< codim >( i ), size );
+              const auto subEntity = element.template subEntity< codim >( i );
+              const std::size_t n = (fixed ? wrappedHandle_.size( subEntity ) : readSize( buffer, std::is_arithmetic< DataType >() ));
+              wrappedHandle_.scatter( buffer, subEntity, n );
             }
           } );
       }
@@ -114,8 +183,67 @@ namespace Dune
       const DataSet &dataSet () const { return dataSet_; }
 
     protected:
+      template< class HostEntity >
+      static Element element ( const DataSet &dataSet, const HostEntity &hostEntity )
+      {
+        return Element( InterfaceGridEntity< 0, dimension, const Grid >( dataSet, hostEntity ) );
+      }
+
+      template< class HostEntity >
+      Element element ( const HostEntity &hostEntity ) const
+      {
+        return element( dataSet(), hostEntity );
+      }
+
+      template< class MessageBuffer >
+      static void writeSize ( MessageBuffer &buffer, std::size_t size, std::true_type )
+      {
+        if( size > maxSize( std::is_integral< DataType >() ) )
+          DUNE_THROW( NotImplemented, "Variable size communication on InterfaceGrid: DataType cannot represent the size " << size );
+        buffer.write( static_cast< DataType >( size ) );
+      }
+
+      template< class MessageBuffer >
+      static void writeSize ( MessageBuffer &buffer, std::size_t size, std::false_type )
+      {
+        DUNE_THROW( NotImplemented, "Variable size communication on InterfaceGrid requires an arithmetic DataType" );
+      }
+
+      template< class MessageBuffer >
+      static std::size_t readSize ( MessageBuffer &buffer, std::true_type )
+      {
+        DataType size;
+        buffer.read( size );
+        return static_cast< std::size_t >( size );
+      }
+
+      template< class MessageBuffer >
+      static std::size_t readSize ( MessageBuffer &buffer, std::false_type )
+      {
+        DUNE_THROW( NotImplemented, "Variable size communication on InterfaceGrid requires an arithmetic DataType" );
+      }
+
+      // largest size exactly representable by DataType
+      static std::size_t maxSize ( std::true_type )
+      {
+        typedef std::numeric_limits< DataType > Limits;
+        if( Limits::max() <= 0 )
+          return 0;
+        return static_cast< std::size_t >( std::min< unsigned long long >( static_cast< unsigned long long >( Limits::max() ), std::numeric_limits< std::size_t >::max() ) );
+      }
+
+      static std::size_t maxSize ( std::false_type )
+      {
+        typedef std::numeric_limits< DataType > Limits;
+        if( Limits::digits >= std::numeric_limits< std::size_t >::digits )
+          return std::numeric_limits< std::size_t >::max();
+        return std::size_t( 1 ) << Limits::digits;
+      }
+
       const DataSet &dataSet_;
       WrappedHandle &wrappedHandle_;
+      bool fixedSize_;
+      std::size_t elementSize_;
     };
 
   } // namespace VoF
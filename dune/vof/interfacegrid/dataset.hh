@@ -2,16 +2,26 @@
 #define DUNE_VOF_INTERFACEGRID_DATASET_HH
 
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <dune/common/exceptions.hh>
+
 #include <dune/geometry/dimension.hh>
 
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
 #include <dune/vof/colorfunction.hh>
 #include <dune/vof/flagset.hh>
 #include <dune/vof/flagging.hh>
+#include <dune/vof/geometry/polytope.hh>
 #include <dune/vof/interfacegrid/geometry.hh>
 #include <dune/vof/mixedcellmapper.hh>
 #include <dune/vof/reconstructionset.hh>
@@ -26,6 +36,12 @@ namespace Dune
     // BasicInterfaceGridDataSet
     // -------------------------
 
+    /**
+     * \brief flags of an interface grid, either computed by the data set or adopted
+     * \details Constructed from a color function, the data set owns flagging, reconstruction
+     *          and their results. Constructed from a flag set, it only refers to the flags of the
+     *          caller, which must outlive the data set; nothing is recomputed or copied.
+     */
     template< class R >
     struct BasicInterfaceGridDataSet
     {
@@ -44,34 +60,69 @@ namespace Dune
 
       template< class ColorFunction, class... Args >
       explicit BasicInterfaceGridDataSet ( const ColorFunction &colorFunction, Args &&... args )
-        : reconstruction_( std::forward< Args >( args )... ),
-          flagging_ ( 1e-6 ),
-          flags_( colorFunction.gridView() ),
-          reconstructionSet_( colorFunction.gridView() )
+        : pipeline_( new Pipeline( colorFunction.gridView(), std::forward< Args >( args )... ) ),
+          flags_( &pipeline_->flags )
       {
         update( colorFunction );
       }
 
-      const Reconstruction &reconstruction () { return reconstruction_; }
-      const Flags &flags () const { return flags_; }
-      const ReconstructionSet &reconstructionSet () const { return reconstructionSet_; }
+      explicit BasicInterfaceGridDataSet ( const Flags &flags )
+        : flags_( &flags )
+      {}
+
+      BasicInterfaceGridDataSet ( const BasicInterfaceGridDataSet &other )
+        : pipeline_( other.pipeline_ ? new Pipeline( *other.pipeline_ ) : nullptr ),
+          flags_( pipeline_ ? &pipeline_->flags : other.flags_ )
+      {}
+
+      BasicInterfaceGridDataSet ( BasicInterfaceGridDataSet && ) = default;
+
+      bool ownsReconstruction () const { return static_cast< bool >( pipeline_ ); }
+
+      const Reconstruction &reconstruction () const { return pipeline().reconstruction; }
+      const Flags &flags () const { return *flags_; }
+      const ReconstructionSet &reconstructionSet () const { return pipeline().reconstructionSet; }
 
       const GridView &gridView () const { return flags().gridView(); }
 
       template< class ColorFunction >
       void update ( const ColorFunction &colorFunction )
       {
-        flagging_( colorFunction, flags_ );
-        reconstruction_( colorFunction, reconstructionSet_, flags_ );
+        Pipeline &pipeline = this->pipeline();
+        pipeline.flagging( colorFunction, pipeline.flags );
+        pipeline.reconstruction( colorFunction, pipeline.reconstructionSet, pipeline.flags );
       }
 
-      const GlobalCoordinate &normal ( const Element &element ) const { return reconstructionSet()[ element ].innerNormal(); }
+      void update ( const Flags &flags )
+      {
+        if( ownsReconstruction() )
+          DUNE_THROW( InvalidStateException, "Interface grid computing its own flags cannot adopt external flags" );
+        flags_ = &flags;
+      }
 
-    protected:
-      Reconstruction reconstruction_;
-      Flagging flagging_;
-      Flags flags_;
-      ReconstructionSet reconstructionSet_;
+    private:
+      struct Pipeline
+      {
+        template< class... Args >
+        explicit Pipeline ( const GridView &gridView, Args &&... args )
+          : reconstruction( std::forward< Args >( args )... ), flagging( 1e-6 ), flags( gridView ), reconstructionSet( gridView )
+        {}
+
+        Reconstruction reconstruction;
+        Flagging flagging;
+        Flags flags;
+        ReconstructionSet reconstructionSet;
+      };
+
+      Pipeline &pipeline () const
+      {
+        if( !ownsReconstruction() )
+          DUNE_THROW( InvalidStateException, "Interface grid on adopted flags and reconstructions has no reconstruction of its own" );
+        return *pipeline_;
+      }
+
+      std::unique_ptr< Pipeline > pipeline_;
+      const Flags *flags_;
     };
 
 
@@ -88,53 +139,90 @@ namespace Dune
 
     public:
       using Base::flags;
-      using Base::reconstructionSet;
-      using Base::normal;
+      using Base::gridView;
 
       typedef typename Base::Element Element;
       typedef typename Base::GridView GridView;
+      typedef typename Base::Flags Flags;
       typedef typename Base::GlobalCoordinate GlobalCoordinate;
 
       typedef MixedCellMapper< GridView > Indices;
       typedef std::vector< GlobalCoordinate > Vertices;
       typedef std::vector< std::size_t > Offsets;
 
+      typedef typename Base::ReconstructionSet::DataType HalfSpace;
+      typedef std::vector< HalfSpace > HalfSpaces;
+
+      typedef typename Element::EntitySeed ElementSeed;
+      typedef std::vector< ElementSeed > Seeds;
+
       typedef typename GridView::ctype ctype;
 
+      typedef std::vector< ctype > Volumes;
+
+      typedef std::vector< typename Indices::Index > Origin;
+
+      static const int mydimension = GridView::dimension-1;
+
       template< int mydim >
       using Geometry = BasicInterfaceGridGeometry< ctype, mydim, GridView::dimensionworld >;
 
-      template< class ColorFunction, class... Args >
+      template< class ColorFunction, class... Args, std::enable_if_t< !std::is_same< ColorFunction, Flags >::value, int > = 0 >
       explicit InterfaceGridDataSet ( const ColorFunction &colorFunction, Args &&... args )
         : Base( colorFunction, std::forward< Args >( args )... ), indices_( flags() )
       {
-        getInterfaceVertices( reconstructionSet(), flags(), vertices_, offsets_ );
+        build( Base::reconstructionSet() );
+      }
+
+      /**
+       * \brief adopt flags and reconstructions computed elsewhere, e.g., by Algorithm
+       * \details Both are referenced, not copied, and must outlive the data set. Any
+       *          reconstruction set providing read access for all elements can be used.
+       */
+      template< class ReconstructionSet >
+      InterfaceGridDataSet ( const Flags &flags, const ReconstructionSet &reconstructions )
+        : Base( flags ), indices_( flags )
+      {
+        build( reconstructions );
       }
 
+      /**
+       * \brief update the interface for a new color function
+       * \details Flags and reconstructions are recomputed. Elements that stay mixed keep their
+       *          index where possible (see MixedCellMapper::update) and the interface polygon is
+       *          only recomputed if the reconstruction changed. If no element changed its index and
+       *          no polygon changed its number of vertices, the vertices are patched in place.
+       */
       template< class ColorFunction >
       void update ( const ColorFunction &colorFunction )
       {
         Base::update( colorFunction );
-        indices_.update( flags() );
-        getInterfaceVertices( reconstructionSet(), flags(), vertices_, offsets_ );
+        rebuild( Base::reconstructionSet() );
       }
 
-      void covariantOuterNormal ( const Element &element, std::size_t i, FieldVector< ctype, 2 > &n ) const
+      /**
+       * \brief update the interface from adopted flags and reconstructions
+       * \details Nothing is recomputed except for the polygons of changed reconstructions.
+       */
+      template< class ReconstructionSet >
+      void update ( const Flags &flags, const ReconstructionSet &reconstructions )
       {
-        const auto elementIndex = indices().index( element );
-        const std::size_t index = offsets()[ elementIndex ];
-        const std::size_t size = offsets()[ elementIndex + 1 ] - index;
-        assert( i < size );
-        n = vertices()[ index + i ] - vertices()[ index + (i + 1) % size ];
+        Base::update( flags );
+        rebuild( reconstructions );
       }
 
-      void covariantOuterNormal ( const Element &element, std::size_t i, FieldVector< ctype, 3 > &n ) const
+      const GlobalCoordinate &normal ( const Element &element ) const { return halfSpaces_[ indices().index( element ) ].innerNormal(); }
+
+      const GlobalCoordinate &center ( const Element &element ) const { return centers_[ indices().index( element ) ]; }
+
+      ctype volume ( const Element &element ) const { return volumes_[ indices().index( element ) ]; }
+
+      void covariantOuterNormal ( const Element &element, std::size_t i, GlobalCoordinate &n ) const
       {
         const auto elementIndex = indices().index( element );
         const std::size_t index = offsets()[ elementIndex ];
-        const std::size_t size = offsets()[ elementIndex + 1 ] - index;
-        assert( i < size );
-        n = generalizedCrossProduct( vertices()[ index + (i + 1) % size ] - vertices()[ index + i ], normal( element ) );
+        assert( index + i < offsets()[ elementIndex + 1 ] );
+        n = outerNormals_[ index + i ];
       }
 
       Geometry< 0 > geometry ( const Element &element, std::size_t i, Dune::Dim< 0 > ) const
@@ -164,10 +252,233 @@ namespace Dune
       const Vertices &vertices () const { return vertices_; }
       const Offsets &offsets () const { return offsets_; }
 
+      /**
+       * \brief seeds of all mixed host elements in host iteration order
+       */
+      const Seeds &seeds () const { return seeds_; }
+
+      /**
+       * \name cached geometry
+       * \details Computed once per update. Element data is indexed by indices(), edge and
+       *          triangle data like vertices(): edge i of an element connects its vertices i and
+       *          i+1, and, for polygons, triangle i is spanned by the center and edge i.
+       * \{
+       */
+      const HalfSpaces &halfSpaces () const { return halfSpaces_; }
+      const Vertices &centers () const { return centers_; }
+      const Volumes &volumes () const { return volumes_; }
+      const Vertices &outerNormals () const { return outerNormals_; }
+      const Volumes &triangleVolumes () const { return triangleVolumes_; }
+      /** \} */
+
+      /**
+       * \name changes of the last update
+       * \details origin() holds the previous index of each element (Indices::invalidIndex() for
+       *          new elements) and previousOffsets() the previous vertex offsets, so data attached
+       *          to the interface can follow it (see PersistentContainer). The generation counts
+       *          the updates of this data set.
+       * \{
+       */
+      const Origin &origin () const { return origin_; }
+      const Offsets &previousOffsets () const { return previousOffsets_; }
+      std::size_t generation () const { return generation_; }
+      /** \} */
+
     private:
+      template< class ReconstructionSet >
+      void build ( const ReconstructionSet &reconstructions )
+      {
+        getInterfaceVertices( reconstructions, flags(), vertices_, offsets_ );
+
+        halfSpaces_.resize( indices().size() );
+        seeds_.clear();
+        for( const auto &element : elements( gridView(), Partitions::all ) )
+        {
+          if( !flags().isMixed( element ) )
+            continue;
+
+          halfSpaces_[ indices().index( element ) ] = reconstructions[ element ];
+          seeds_.push_back( element.seed() );
+        }
+
+        cacheGeometry();
+      }
+
+      template< class ReconstructionSet >
+      void rebuild ( const ReconstructionSet &reconstructions )
+      {
+        Origin origin;
+        indices_.update( flags(), origin );
+        const std::size_t size = origin.size();
+
+        // vertex range of each polygon, either in the previous vertices or in computed
+        HalfSpaces halfSpaces( size );
+        Vertices computed;
+        Offsets begin( size ), count( size );
+        std::vector< bool > kept( size, false );
+        seeds_.clear();
+        for( const auto &element : elements( gridView(), Partitions::all ) )
+        {
+          if( !flags().isMixed( element ) )
+            continue;
+
+          seeds_.push_back( element.seed() );
+          const auto index = indices().index( element );
+          const auto previous = origin[ index ];
+          halfSpaces[ index ] = reconstructions[ element ];
+          if( (previous != Indices::invalidIndex()) && equals( halfSpaces_[ previous ], halfSpaces[ index ] ) )
+          {
+            kept[ index ] = true;
+            begin[ index ] = offsets_[ previous ];
+            count[ index ] = offsets_[ previous+1 ] - offsets_[ previous ];
+            continue;
+          }
+
+          auto polygon = interface( element, reconstructions );
+          assert( polygon.size() > 0 );
+          begin[ index ] = computed.size();
+          count[ index ] = polygon.size();
+          for( std::size_t i = 0; i < polygon.size(); ++i )
+            computed.push_back( polygon.vertex( i ) );
+        }
+
+        Offsets previousOffsets( offsets_ );
+        bool inPlace = (size+1 == offsets_.size());
+        for( std::size_t i = 0; inPlace && (i < size); ++i )
+          inPlace = (origin[ i ] == i) && (count[ i ] == offsets_[ i+1 ] - offsets_[ i ]);
+
+        if( inPlace )
+        {
+          for( std::size_t i = 0; i < size; ++i )
+            if( !kept[ i ] )
+              std::copy_n( computed.begin() + begin[ i ], count[ i ], vertices_.begin() + offsets_[ i ] );
+        }
+        else
+        {
+          Offsets offsets( size+1, 0 );
+          for( std::size_t i = 0; i < size; ++i )
+            offsets[ i+1 ] = offsets[ i ] + count[ i ];
+
+          Vertices vertices( offsets[ size ] );
+          for( std::size_t i = 0; i < size; ++i )
+          {
+            const Vertices &source = (kept[ i ] ? vertices_ : computed);
+            std::copy_n( source.begin() + begin[ i ], count[ i ], vertices.begin() + offsets[ i ] );
+          }
+
+          vertices_.swap( vertices );
+          offsets_.swap( offsets );
+        }
+
+        halfSpaces_.swap( halfSpaces );
+        cacheGeometry( origin, previousOffsets, kept );
+
+        previousOffsets_.swap( previousOffsets );
+        origin_.swap( origin );
+        ++generation_;
+      }
+
+      void cacheGeometry ()
+      {
+        const std::size_t size = indices().size();
+        centers_.resize( size );
+        volumes_.resize( size );
+        outerNormals_.resize( vertices_.size() );
+        triangleVolumes_.resize( mydimension == 2 ? vertices_.size() : 0u );
+
+        for( std::size_t i = 0; i < size; ++i )
+          cacheGeometry( i );
+      }
+
+      // take the cached geometry of unchanged polygons from their previous index
+      void cacheGeometry ( const Origin &origin, const Offsets &previousOffsets, const std::vector< bool > &kept )
+      {
+        const std::size_t size = indices().size();
+        Vertices centers( size ), outerNormals( vertices_.size() );
+        Volumes volumes( size ), triangleVolumes( mydimension == 2 ? vertices_.size() : 0u );
+        for( std::size_t i = 0; i < size; ++i )
+        {
+          if( !kept[ i ] )
+            continue;
+
+          const std::size_t previous = origin[ i ];
+          const std::size_t begin = offsets_[ i ], previousBegin = previousOffsets[ previous ];
+          const std::size_t count = offsets_[ i+1 ] - begin;
+          centers[ i ] = centers_[ previous ];
+          volumes[ i ] = volumes_[ previous ];
+          std::copy_n( outerNormals_.begin() + previousBegin, count, outerNormals.begin() + begin );
+          if( mydimension == 2 )
+            std::copy_n( triangleVolumes_.begin() + previousBegin, count, triangleVolumes.begin() + begin );
+        }
+
+        centers_.swap( centers );
+        volumes_.swap( volumes );
+        outerNormals_.swap( outerNormals );
+        triangleVolumes_.swap( triangleVolumes );
+
+        for( std::size_t i = 0; i < size; ++i )
+          if( !kept[ i ] )
+            cacheGeometry( i );
+      }
+
+      void cacheGeometry ( std::size_t i )
+      {
+        const std::size_t begin = offsets_[ i ];
+        const std::size_t count = offsets_[ i+1 ] - begin;
+        const GlobalCoordinate &normal = halfSpaces_[ i ].innerNormal();
+
+        const Geometry< mydimension > geometry( normal, vertices_.data() + begin, count );
+        centers_[ i ] = geometry.center();
+        volumes_[ i ] = geometry.volume();
+
+        for( std::size_t j = 0; j < count; ++j )
+        {
+          const GlobalCoordinate &x = vertices_[ begin + j ];
+          const GlobalCoordinate &y = vertices_[ begin + (j+1) % count ];
+          outerNormals_[ begin + j ] = outerNormal( x, y, normal );
+          if( mydimension == 2 )
+            triangleVolumes_[ begin + j ] = triangleVolume( centers_[ i ], x, y, normal );
+        }
+      }
+
+      static FieldVector< ctype, 2 > outerNormal ( const FieldVector< ctype, 2 > &x, const FieldVector< ctype, 2 > &y, const FieldVector< ctype, 2 > &normal )
+      {
+        return x - y;
+      }
+
+      static FieldVector< ctype, 3 > outerNormal ( const FieldVector< ctype, 3 > &x, const FieldVector< ctype, 3 > &y, const FieldVector< ctype, 3 > &normal )
+      {
+        return generalizedCrossProduct( y - x, normal );
+      }
+
+      static ctype triangleVolume ( const FieldVector< ctype, 2 > &c, const FieldVector< ctype, 2 > &x, const FieldVector< ctype, 2 > &y, const FieldVector< ctype, 2 > &normal )
+      {
+        return 0;
+      }
+
+      static ctype triangleVolume ( const FieldVector< ctype, 3 > &c, const FieldVector< ctype, 3 > &x, const FieldVector< ctype, 3 > &y, const FieldVector< ctype, 3 > &normal )
+      {
+        using std::abs;
+        return abs( generalizedCrossProduct( x - c, y - c ) * normal ) / ctype( 2 );
+      }
+
+      static bool equals ( const HalfSpace &a, const HalfSpace &b )
+      {
+        return (a.innerNormal() == b.innerNormal()) && (a.distance() == b.distance());
+      }
+
       Indices indices_;
       Vertices vertices_;
       Offsets offsets_;
+      HalfSpaces halfSpaces_;
+      Seeds seeds_;
+      Vertices centers_;
+      Volumes volumes_;
+      Vertices outerNormals_;
+      Volumes triangleVolumes_;
+      Origin origin_;
+      Offsets previousOffsets_;
+      std::size_t generation_ = 0;
     };
 
   } // namespace VoF
@@ -195,7 +195,7 @@ namespace Dune
         const auto elementIndex = dataSet().indices().index( hostElement() );
         const std::size_t index = dataSet().offsets()[ elementIndex ];
         const std::size_t size = dataSet().offsets()[ elementIndex + 1 ] - index;
-        return Geometry( Impl( normal(), dataSet().vertices().data() + index, size ) );
+        return Geometry( Impl( normal(), dataSet().vertices().data() + index, size, dataSet().centers()[ elementIndex ], dataSet().volumes()[ elementIndex ] ) );
       }
 
       LocalGeometry geometryInFather () const { DUNE_THROW( GridError, "InterfaceGrid consists of only one level" ); }
@@ -177,6 +177,10 @@ namespace Dune
       explicit BasicInterfaceGridGeometry ( const GlobalCoordinate &normal, const GlobalCoordinate *cbegin, std::size_t csize  )
         : Base( ReferenceElements< ctype, 0 >::cube(), cbegin[ 0 ], {} )
       {}
+
+      BasicInterfaceGridGeometry ( const GlobalCoordinate &normal, const GlobalCoordinate *cbegin, std::size_t csize, const GlobalCoordinate &center, ctype volume )
+        : This( normal, cbegin, csize )
+      {}
     };
 
     template< class ctype, int cdim >
@@ -198,6 +202,10 @@ namespace Dune
       {
         assert( csize == 2u );
       }
+
+      BasicInterfaceGridGeometry ( const GlobalCoordinate &normal, const GlobalCoordinate *cbegin, std::size_t csize, const GlobalCoordinate &center, ctype volume )
+        : This( normal, cbegin, csize )
+      {}
     };
 
     template< class ctype, int cdim >
@@ -211,12 +219,27 @@ namespace Dune
       typedef typename Base::GlobalCoordinate GlobalCoordinate;
 
       BasicInterfaceGridGeometry ( const GlobalCoordinate *cbegin, std::size_t csize )
-        : Base( cbegin, csize )
+        : Base( cbegin, csize ), center_( Base::center() ), volume_( Base::volume() )
       {}
 
       BasicInterfaceGridGeometry ( const GlobalCoordinate &normal, const GlobalCoordinate *cbegin, std::size_t csize )
-        : Base( cbegin, csize, normal )
+        : Base( cbegin, csize, normal ), center_( Base::center() ), volume_( Base::volume() )
+      {}
+
+      /**
+       * \brief construct from center and volume cached by the interface grid data set
+       */
+      BasicInterfaceGridGeometry ( const GlobalCoordinate &normal, const GlobalCoordinate *cbegin, std::size_t csize, const GlobalCoordinate &center, ctype volume )
+        : Base( cbegin, csize, normal ), center_( center ), volume_( volume )
       {}
+
+      const GlobalCoordinate &center () const { return center_; }
+
+      ctype volume () const { return volume_; }
+
+    private:
+      GlobalCoordinate center_;
+      ctype volume_;
     };
 
 
@@ -2,6 +2,7 @@
 #define DUNE_VOF_INTERFACEGRID_GRID_HH
 
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
 #include <dune/grid/common/grid.hh>
@@ -130,11 +131,29 @@ namespace Dune
 
       typedef typename Traits::CollectiveCommunication CollectiveCommunication;
 
-      template< class ColorFunction, class... Args >
+      /**
+       * \brief construct the interface of a color function, computing flags and reconstructions
+       *
+       * \param   colorFunction  color function
+       * \param   args           arguments to construct the reconstruction operator
+       */
+      template< class ColorFunction, class... Args, std::enable_if_t< !std::is_same< ColorFunction, Flags >::value, int > = 0 >
       explicit InterfaceGrid ( const ColorFunction &colorFunction, Args &&... args )
         : leafIndexSet_( colorFunction, std::forward< Args >( args )... )
       {}
 
+      /**
+       * \brief construct the interface from flags and reconstructions computed elsewhere
+       * \details Both are referenced, not copied, and must outlive the grid.
+       *
+       * \param   flags            flags of the host grid view
+       * \param   reconstructions  reconstructions of (at least) all mixed elements
+       */
+      template< class ReconstructionSet >
+      InterfaceGrid ( const Flags &flags, const ReconstructionSet &reconstructions )
+        : leafIndexSet_( flags, reconstructions )
+      {}
+
       int maxLevel () const { return 0; }
 
       int size ( int level, int codim ) const { return levelGridView( level ).size( codim ); }
@@ -208,6 +227,9 @@ namespace Dune
       template< class ColorFunction >
       void update ( const ColorFunction &colorFunction ) { leafIndexSet_.update( colorFunction ); }
 
+      template< class ReconstructionSet >
+      void update ( const Flags &flags, const ReconstructionSet &reconstructions ) { leafIndexSet_.update( flags, reconstructions ); }
+
     protected:
       using Base::getRealImplementation;
 
@@ -1,6 +1,8 @@
 #ifndef DUNE_VOF_INTERFACEGRID_GRIDVIEW_HH
 #define DUNE_VOF_INTERFACEGRID_GRIDVIEW_HH
 
+#include <cstddef>
+
 #include <dune/grid/common/gridenums.hh>
 #include <dune/grid/common/gridview.hh>
 
@@ -46,9 +48,6 @@ namespace Dune
 
       typedef typename Reconstruction::GridView::CollectiveCommunication CollectiveCommunication;
 
-      template< PartitionIteratorType pitype >
-      using HostIterator = typename Reconstruction::GridView::template Codim< 0 >::template Partition< pitype >::Iterator;
-
       template< int codim >
       struct Codim
       {
@@ -60,7 +59,7 @@ namespace Dune
         template< PartitionIteratorType pitype >
         struct Partition
         {
-          typedef Dune::EntityIterator< codim, const Grid, InterfaceGridIterator< codim, const Grid, HostIterator< pitype > > > Iterator;
+          typedef Dune::EntityIterator< codim, const Grid, InterfaceGridIterator< codim, const Grid, pitype > > Iterator;
         };
 
         typedef typename Partition< All_Partition >::Iterator Iterator;
@@ -111,8 +110,8 @@ namespace Dune
       template< int codim, PartitionIteratorType pitype >
       typename Codim< codim >::template Partition< pitype >::Iterator begin () const
       {
-        typedef InterfaceGridIterator< codim, const Grid, typename Traits::template HostIterator< pitype > > Impl;
-        return Impl( grid().dataSet(), hostGridView().template begin< 0, pitype >(), hostGridView().template end< 0, pitype >() );
+        typedef InterfaceGridIterator< codim, const Grid, pitype > Impl;
+        return Impl( grid().dataSet(), grid().dataSet().seeds().begin(), grid().dataSet().seeds().end() );
       }
 
       template< int codim >
@@ -124,8 +123,8 @@ namespace Dune
       template< int codim, PartitionIteratorType pitype >
       typename Codim< codim >::template Partition< pitype >::Iterator end () const
       {
-        typedef InterfaceGridIterator< codim, const Grid, typename Traits::template HostIterator< pitype > > Impl;
-        return Impl( grid().dataSet(), hostGridView().template end< 0, pitype >() );
+        typedef InterfaceGridIterator< codim, const Grid, pitype > Impl;
+        return Impl( grid().dataSet(), grid().dataSet().seeds().end() );
       }
 
       template< int codim >
@@ -152,7 +151,14 @@ namespace Dune
       template< class DataHandle, class Data >
       void communicate ( CommDataHandleIF< DataHandle, Data > &dataHandle, InterfaceType interface, CommunicationDirection direction ) const
       {
-        InterfaceGridDataHandle< Grid, CommDataHandleIF< DataHandle, Data > > wrappedDataHandle( grid().dataSet(), dataHandle );
+        typedef InterfaceGridDataHandle< Grid, CommDataHandleIF< DataHandle, Data > > WrappedDataHandle;
+
+        // all ranks must agree on the size of the fixed-size path, also those without interface elements
+        std::size_t elementSize = 0;
+        if( WrappedDataHandle::elementsOnly( dataHandle ) )
+          elementSize = hostGridView().comm().max( WrappedDataHandle::elementSize( grid().dataSet(), dataHandle ) );
+
+        WrappedDataHandle wrappedDataHandle( grid().dataSet(), dataHandle, elementSize );
         hostGridView().communicate( wrappedDataHandle, interface, direction );
       }
 
@@ -71,7 +71,7 @@ namespace Dune
      */
     static const HostGrid &hostGrid ( const Grid &grid )
     {
-      return grid.reconstruction().gridView().grid();
+      return grid.dataSet().gridView().grid();
     }
 
     template< int codim >
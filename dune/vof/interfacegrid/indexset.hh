@@ -68,11 +68,18 @@ namespace Dune
       template< int codim >
       using Codim = typename InterfaceGridIndexSetTraits< Grid >::template Codim< codim >;
 
-      template< class ColorFunction, class... Args >
+      typedef typename DataSet::Flags Flags;
+
+      template< class ColorFunction, class... Args, std::enable_if_t< !std::is_same< ColorFunction, Flags >::value, int > = 0 >
       explicit InterfaceGridIndexSet ( const ColorFunction &colorFunction, Args &&... args )
         : dataSet_( colorFunction, std::forward< Args >( args )... )
       {}
 
+      template< class ReconstructionSet >
+      InterfaceGridIndexSet ( const Flags &flags, const ReconstructionSet &reconstructions )
+        : dataSet_( flags, reconstructions )
+      {}
+
       InterfaceGridIndexSet ( const This &other )
         : dataSet_( other.dataSet_ )
       {}
@@ -139,6 +146,12 @@ namespace Dune
         dataSet_.update( colorFunction );
       }
 
+      template< class ReconstructionSet >
+      void update ( const Flags &flags, const ReconstructionSet &reconstructions )
+      {
+        dataSet_.update( flags, reconstructions );
+      }
+
       const DataSet &dataSet () const { return dataSet_; }
 
     private:
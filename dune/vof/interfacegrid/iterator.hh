@@ -6,6 +6,7 @@
 #include <type_traits>
 
 #include <dune/grid/common/entityiterator.hh>
+#include <dune/grid/common/gridenums.hh>
 
 #include <dune/vof/interfacegrid/dataset.hh>
 #include <dune/vof/interfacegrid/entity.hh>
@@ -19,7 +20,7 @@ namespace Dune
     // Internal Forward Declarations
     // -----------------------------
 
-    template< int codim, class Grid, class HostElementIterator >
+    template< int codim, class Grid, PartitionIteratorType pitype >
     class InterfaceGridIterator;
 
 
@@ -27,10 +28,16 @@ namespace Dune
     // InterfaceGridIterator
     // ---------------------
 
-    template< class Grid, class HostElementIterator >
-    class InterfaceGridIterator< 0, Grid, HostElementIterator >
+    /**
+     * \brief iterator over the elements of an interface grid
+     * \details Iterates the seeds of the mixed host elements kept by the data set, so the cost of
+     *          a traversal is proportional to the number of interface elements. Elements outside
+     *          the partition pitype are skipped.
+     */
+    template< class Grid, PartitionIteratorType pitype >
+    class InterfaceGridIterator< 0, Grid, pitype >
     {
-      typedef InterfaceGridIterator< 0, Grid, HostElementIterator > This;
+      typedef InterfaceGridIterator< 0, Grid, pitype > This;
 
       typedef typename std::remove_const_t< Grid >::Traits Traits;
 
@@ -42,37 +49,69 @@ namespace Dune
 
       typedef InterfaceGridDataSet< typename Traits::Reconstruction > DataSet;
 
+      typedef typename DataSet::Element HostElement;
+      typedef typename DataSet::Seeds::const_iterator SeedIterator;
+
       InterfaceGridIterator () = default;
 
-      InterfaceGridIterator ( const DataSet &dataSet, const HostElementIterator &hostElementBegin, const HostElementIterator &hostElementEnd )
-        : dataSet_( &dataSet ), hostElementIterator_( hostElementBegin ), hostElementEnd_( hostElementEnd )
+      InterfaceGridIterator ( const DataSet &dataSet, const SeedIterator &seedBegin, const SeedIterator &seedEnd )
+        : dataSet_( &dataSet ), seedIterator_( seedBegin ), seedEnd_( seedEnd )
       {
-        for( ; (hostElementIterator_ != hostElementEnd_) && !dataSet.flags().isMixed( *hostElementIterator_ ); ++hostElementIterator_ )
-          continue;
+        findHostElement();
       }
 
-      InterfaceGridIterator ( const DataSet &dataSet, const HostElementIterator &hostElementEnd )
-        : dataSet_( &dataSet ), hostElementIterator_( hostElementEnd ), hostElementEnd_( hostElementEnd )
+      InterfaceGridIterator ( const DataSet &dataSet, const SeedIterator &seedEnd )
+        : dataSet_( &dataSet ), seedIterator_( seedEnd ), seedEnd_( seedEnd )
       {}
 
-      operator bool () const { return dataSet_ && (hostElementIterator_ != hostElementEnd_); }
+      operator bool () const { return dataSet_ && (seedIterator_ != seedEnd_); }
 
-      bool equals ( const This &other ) const { return (hostElementIterator_ == other.hostElementIterator_); }
+      bool equals ( const This &other ) const { return (seedIterator_ == other.seedIterator_); }
 
-      Entity dereference () const { return InterfaceGridEntity< codimension, dimension, Grid >( dataSet(), *hostElementIterator() ); }
+      Entity dereference () const { return InterfaceGridEntity< codimension, dimension, Grid >( dataSet(), hostElement() ); }
 
       void increment ()
       {
-        for( ++hostElementIterator_; (hostElementIterator_ != hostElementEnd_) && !dataSet().flags().isMixed( *hostElementIterator_ ); ++hostElementIterator_ )
-          continue;
+        ++seedIterator_;
+        findHostElement();
       }
 
       const DataSet &dataSet () const { assert( dataSet_ ); return *dataSet_; }
-      const HostElementIterator &hostElementIterator() const { return hostElementIterator_; }
+      const HostElement &hostElement () const { assert( *this ); return hostElement_; }
 
     protected:
-      const DataSet *dataSet_;
-      HostElementIterator hostElementIterator_, hostElementEnd_;
+      static bool contains ( PartitionType partitionType )
+      {
+        switch( pitype )
+        {
+        case Interior_Partition:
+          return (partitionType == InteriorEntity);
+        case InteriorBorder_Partition:
+          return (partitionType == InteriorEntity) || (partitionType == BorderEntity);
+        case Overlap_Partition:
+          return (partitionType == InteriorEntity) || (partitionType == BorderEntity) || (partitionType == OverlapEntity);
+        case OverlapFront_Partition:
+          return (partitionType != GhostEntity);
+        case Ghost_Partition:
+          return (partitionType == GhostEntity);
+        default:
+          return true;
+        }
+      }
+
+      void findHostElement ()
+      {
+        for( ; seedIterator_ != seedEnd_; ++seedIterator_ )
+        {
+          hostElement_ = dataSet().gridView().grid().entity( *seedIterator_ );
+          if( (pitype == All_Partition) || contains( hostElement_.partitionType() ) )
+            return;
+        }
+      }
+
+      const DataSet *dataSet_ = nullptr;
+      SeedIterator seedIterator_, seedEnd_;
+      HostElement hostElement_;
     };
 
 
@@ -80,14 +119,14 @@ namespace Dune
     // InterfaceGridIterator
     // ---------------------
 
-    template< int codim, class Grid, class HostElementIterator >
+    template< int codim, class Grid, PartitionIteratorType pitype >
     class InterfaceGridIterator
     {
-      typedef InterfaceGridIterator< codim, Grid, HostElementIterator > This;
+      typedef InterfaceGridIterator< codim, Grid, pitype > This;
 
       typedef typename std::remove_const_t< Grid >::Traits Traits;
 
-      typedef InterfaceGridIterator< 0, Grid, HostElementIterator > ElementIterator;
+      typedef InterfaceGridIterator< 0, Grid, pitype > ElementIterator;
 
     public:
       static const int codimension = codim;
@@ -96,23 +135,25 @@ namespace Dune
       typedef Dune::Entity< codimension, dimension, Grid, InterfaceGridEntity > Entity;
 
       typedef typename ElementIterator::DataSet DataSet;
+      typedef typename ElementIterator::HostElement HostElement;
+      typedef typename ElementIterator::SeedIterator SeedIterator;
 
       InterfaceGridIterator () = default;
 
-      InterfaceGridIterator ( const DataSet &dataSet, const HostElementIterator &hostElementBegin, const HostElementIterator &hostElementEnd )
-        : elementIterator_( dataSet, hostElementBegin, hostElementEnd ),
-          subEntities_(*this ? dataSet.numVertices( *hostElementIterator() ) : 0)
+      InterfaceGridIterator ( const DataSet &dataSet, const SeedIterator &seedBegin, const SeedIterator &seedEnd )
+        : elementIterator_( dataSet, seedBegin, seedEnd ),
+          subEntities_(*this ? dataSet.numVertices( hostElement() ) : 0)
       {}
 
-      InterfaceGridIterator ( const DataSet &dataSet, const HostElementIterator &hostElementEnd )
-        : elementIterator_( dataSet, hostElementEnd )
+      InterfaceGridIterator ( const DataSet &dataSet, const SeedIterator &seedEnd )
+        : elementIterator_( dataSet, seedEnd )
       {}
 
       operator bool () const { return static_cast< bool >( elementIterator_ ); }
 
       bool equals ( const This &other ) const { return elementIterator_.equals( other.elementIterator_) && (subEntity_ == other.subEntity_); }
 
-      Entity dereference () const { return InterfaceGridEntity< codimension, dimension, Grid >( dataSet(), *hostElementIterator(), subEntity_ ); }
+      Entity dereference () const { return InterfaceGridEntity< codimension, dimension, Grid >( dataSet(), hostElement(), subEntity_ ); }
 
       void increment ()
       {
@@ -121,11 +162,11 @@ namespace Dune
 
         elementIterator_.increment();
         subEntity_ = 0;
-        subEntities_ = (*this ? dataSet().numVertices( *hostElementIterator() ) : 0);
+        subEntities_ = (*this ? dataSet().numVertices( hostElement() ) : 0);
       }
 
       const DataSet &dataSet () const { return elementIterator_.dataSet(); }
-      const HostElementIterator &hostElementIterator() const { return elementIterator_.hostElementIterator(); }
+      const HostElement &hostElement () const { return elementIterator_.hostElement(); }
 
     private:
       ElementIterator elementIterator_;
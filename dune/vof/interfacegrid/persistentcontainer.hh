@@ -1,8 +1,13 @@
 #ifndef DUNE_VOF_INTERFACEGRID_PERSISTENTCONTAINER_HH
 #define DUNE_VOF_INTERFACEGRID_PERSISTENTCONTAINER_HH
 
+#include <cstddef>
+
+#include <utility>
 #include <vector>
 
+#include <dune/common/exceptions.hh>
+
 #include <dune/grid/utility/persistentcontainer.hh>
 #include <dune/grid/utility/persistentcontainervector.hh>
 
@@ -15,10 +20,19 @@ namespace Dune
   // PersistentContainer for InterfaceGrid
   // -------------------------------------
 
+  /**
+   * \brief persistent container for data attached to the interface
+   * \details After each update of the interface grid, call resize to move the data along with
+   *          the interface. Elements keep their data, elements new to the interface are
+   *          initialized with the given value. Data on vertices and edges is kept if the element
+   *          did not change its number of vertices. The container must be resized after every
+   *          update of the grid; missing an update raises an InvalidStateException.
+   */
   template< class Reconstruction, class T >
   class PersistentContainer< VoF::InterfaceGrid< Reconstruction >, T >
     : public PersistentContainerVector< VoF::InterfaceGrid< Reconstruction >, VoF::InterfaceGridIndexSet< const VoF::InterfaceGrid< Reconstruction > >, std::vector< T > >
   {
+    typedef PersistentContainer< VoF::InterfaceGrid< Reconstruction >, T > This;
     typedef PersistentContainerVector< VoF::InterfaceGrid< Reconstruction >, VoF::InterfaceGridIndexSet< const VoF::InterfaceGrid< Reconstruction > >, std::vector< T > > Base;
 
   public:
@@ -26,8 +40,50 @@ namespace Dune
     typedef typename Base::Value Value;
 
     PersistentContainer ( const Grid &grid, int codim, const Value &value = Value() )
-      : Base( grid.leafIndexSet(), codim, value )
+      : Base( grid.leafIndexSet(), codim, value ), generation_( grid.dataSet().generation() )
     {}
+
+    void resize ( const Value &value = Value() )
+    {
+      const auto &dataSet = this->indexSet().dataSet();
+      if( generation_ == dataSet.generation() )
+        return Base::resize( value );
+      if( generation_ + 1 != dataSet.generation() )
+        DUNE_THROW( InvalidStateException, "PersistentContainer was not resized after each update of the interface grid" );
+
+      const auto &origin = dataSet.origin();
+      std::vector< T > data( this->indexSet().size( this->codimension() ), value );
+      for( std::size_t i = 0; i < origin.size(); ++i )
+      {
+        const std::size_t previous = origin[ i ];
+        if( previous == dataSet.indices().invalidIndex() )
+          continue;
+
+        if( this->codimension() == 0 )
+          data[ i ] = std::move( this->data_[ previous ] );
+        else
+        {
+          const std::size_t begin = dataSet.offsets()[ i ], count = dataSet.offsets()[ i+1 ] - begin;
+          const std::size_t previousBegin = dataSet.previousOffsets()[ previous ];
+          if( count != dataSet.previousOffsets()[ previous+1 ] - previousBegin )
+            continue;
+          for( std::size_t j = 0; j < count; ++j )
+            data[ begin + j ] = std::move( this->data_[ previousBegin + j ] );
+        }
+      }
+
+      this->data_.swap( data );
+      generation_ = dataSet.generation();
+    }
+
+    void swap ( This &other )
+    {
+      Base::swap( other );
+      std::swap( generation_, other.generation_ );
+    }
+
+  private:
+    std::size_t generation_;
   };
 
 } // namespace Dune
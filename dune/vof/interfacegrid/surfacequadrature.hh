@@ -0,0 +1,189 @@
+#ifndef DUNE_VOF_INTERFACEGRID_SURFACEQUADRATURE_HH
+#define DUNE_VOF_INTERFACEGRID_SURFACEQUADRATURE_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune
+{
+
+  namespace VoF
+  {
+
+    // SurfaceQuadrature
+    // -----------------
+
+    /**
+     * \ingroup Other
+     * \brief quadrature over all elements of an InterfaceGrid
+     * \details Segments carry a Gauss rule, polygons are split into the fan of triangles around
+     *          their center cached by the grid, each carrying a simplex rule of the given order.
+     *          Points and weights of the whole interface are computed once per update and stored
+     *          contiguously, so an integral is a single loop over flat arrays. Call update after
+     *          each update of the grid.
+     *
+     * \tparam  Grid  interface grid
+     */
+    template< class Grid >
+    class SurfaceQuadrature
+    {
+      typedef typename Grid::DataSet DataSet;
+
+    public:
+      static const int mydimension = DataSet::mydimension;
+
+      typedef typename DataSet::ctype ctype;
+      typedef typename DataSet::GlobalCoordinate GlobalCoordinate;
+
+      typedef std::vector< GlobalCoordinate > Points;
+      typedef std::vector< ctype > Weights;
+      typedef std::vector< std::size_t > Offsets;
+
+      SurfaceQuadrature ( const Grid &grid, int order )
+        : grid_( grid ), rule_( QuadratureRules< ctype, mydimension >::rule( GeometryTypes::simplex( mydimension ), order ) )
+      {
+        update();
+      }
+
+      /**
+       * \brief recompute points and weights from the cached geometry of the grid
+       */
+      void update ()
+      {
+        const DataSet &dataSet = grid_.dataSet();
+        const std::size_t size = dataSet.indices().size();
+
+        points_.clear();
+        weights_.clear();
+        offsets_.assign( 1, 0u );
+        for( std::size_t i = 0; i < size; ++i )
+        {
+          addPoints( dataSet, i, std::integral_constant< int, mydimension >() );
+          offsets_.push_back( points_.size() );
+        }
+
+        interior_.assign( size, false );
+        const auto gridView = grid_.leafGridView();
+        for( const auto &element : elements( gridView, Partitions::interior ) )
+          interior_[ gridView.indexSet().index( element ) ] = true;
+      }
+
+      /**
+       * \brief integrate f over all interior interface elements of this rank
+       * \details f( x, normal, index ) is called for each quadrature point x, with the inner normal
+       *          and the index of the interface element. The result type must provide *= and +=
+       *          and be constructible from 0. Sum over ranks to obtain the global integral.
+       */
+      template< class F >
+      auto integrate ( F &&f ) const
+      {
+        typedef std::decay_t< decltype( f( std::declval< const GlobalCoordinate & >(), std::declval< const GlobalCoordinate & >(), std::size_t() ) ) > Result;
+
+        const DataSet &dataSet = grid_.dataSet();
+        Result sum( 0 );
+        for( std::size_t i = 0; i + 1 < offsets_.size(); ++i )
+        {
+          if( !interior_[ i ] )
+            continue;
+
+          const GlobalCoordinate &normal = dataSet.halfSpaces()[ i ].innerNormal();
+          for( std::size_t q = offsets_[ i ]; q < offsets_[ i+1 ]; ++q )
+          {
+            Result value = f( points_[ q ], normal, i );
+            value *= weights_[ q ];
+            sum += value;
+          }
+        }
+        return sum;
+      }
+
+      /**
+       * \brief integrate f over each interface element
+       * \details values is indexed by the index set of the interface grid and must have one entry
+       *          per element; all elements, ghosts included, are integrated.
+       */
+      template< class F, class Values >
+      void integrate ( F &&f, Values &values ) const
+      {
+        const DataSet &dataSet = grid_.dataSet();
+        for( std::size_t i = 0; i + 1 < offsets_.size(); ++i )
+        {
+          const GlobalCoordinate &normal = dataSet.halfSpaces()[ i ].innerNormal();
+          values[ i ] = 0;
+          for( std::size_t q = offsets_[ i ]; q < offsets_[ i+1 ]; ++q )
+          {
+            auto value = f( points_[ q ], normal, i );
+            value *= weights_[ q ];
+            values[ i ] += value;
+          }
+        }
+      }
+
+      const Points &points () const { return points_; }
+      const Weights &weights () const { return weights_; }
+      const Offsets &offsets () const { return offsets_; }
+
+    private:
+      // segment from vertex 0 to vertex 1
+      void addPoints ( const DataSet &dataSet, std::size_t i, std::integral_constant< int, 1 > )
+      {
+        const std::size_t begin = dataSet.offsets()[ i ];
+        assert( dataSet.offsets()[ i+1 ] - begin == 2u );
+
+        const GlobalCoordinate &x = dataSet.vertices()[ begin ];
+        const GlobalCoordinate &y = dataSet.vertices()[ begin+1 ];
+        for( const auto &qp : rule_ )
+        {
+          GlobalCoordinate point( x );
+          point.axpy( qp.position()[ 0 ], y - x );
+          points_.push_back( point );
+          weights_.push_back( qp.weight() * dataSet.volumes()[ i ] );
+        }
+      }
+
+      // fan of triangles around the center, the reference triangle has volume 1/2
+      void addPoints ( const DataSet &dataSet, std::size_t i, std::integral_constant< int, 2 > )
+      {
+        const std::size_t begin = dataSet.offsets()[ i ];
+        const std::size_t count = dataSet.offsets()[ i+1 ] - begin;
+        const GlobalCoordinate &c = dataSet.centers()[ i ];
+
+        for( std::size_t j = 0; j < count; ++j )
+        {
+          const GlobalCoordinate x = dataSet.vertices()[ begin + j ] - c;
+          const GlobalCoordinate y = dataSet.vertices()[ begin + (j+1) % count ] - c;
+          const ctype volume = dataSet.triangleVolumes()[ begin + j ];
+          for( const auto &qp : rule_ )
+          {
+            GlobalCoordinate point( c );
+            point.axpy( qp.position()[ 0 ], x );
+            point.axpy( qp.position()[ 1 ], y );
+            points_.push_back( point );
+            weights_.push_back( qp.weight() * ctype( 2 ) * volume );
+          }
+        }
+      }
+
+      const Grid &grid_;
+      const QuadratureRule< ctype, mydimension > &rule_;
+      Points points_;
+      Weights weights_;
+      Offsets offsets_;
+      std::vector< bool > interior_;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_INTERFACEGRID_SURFACEQUADRATURE_HH
@@ -0,0 +1,141 @@
+#ifndef DUNE_VOF_IO_BLOCKIO_HH
+#define DUNE_VOF_IO_BLOCKIO_HH
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif // #if HAVE_ZLIB
+
+#include <dune/common/exceptions.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // writeBlock
+    // ----------
+
+    /**
+     * \ingroup Other
+     * \brief write n trivially copyable values with a single write to the underlying std::ostream
+     *
+     * \param   in    binary output stream providing stream()
+     * \param   data  first value
+     * \param   n     number of values
+     */
+    template< class BinaryInStream, class V >
+    void writeBlock ( BinaryInStream &in, const V *data, std::size_t n )
+    {
+      in.stream().write( reinterpret_cast< const char * >( data ), n * sizeof( V ) );
+    }
+
+
+
+    // readBlock
+    // ---------
+
+    /**
+     * \ingroup Other
+     * \brief read n trivially copyable values with a single read from the underlying std::istream
+     *
+     * \param   out   binary input stream providing stream()
+     * \param   data  first value
+     * \param   n     number of values
+     */
+    template< class BinaryOutStream, class V >
+    void readBlock ( BinaryOutStream &out, V *data, std::size_t n )
+    {
+      out.stream().read( reinterpret_cast< char * >( data ), n * sizeof( V ) );
+      if( !out.stream() )
+        DUNE_THROW( IOError, "Unable to read data block" );
+    }
+
+
+
+
+    // writeCompressedBlock
+    // --------------------
+
+    /**
+     * \ingroup Other
+     * \brief write n trivially copyable values byte shuffled and zlib compressed
+     * \details The k-th bytes of all values are grouped before compression. For volume
+     *          fractions, which are mostly exactly 0 or 1 and vary smoothly across the interface,
+     *          sign, exponent and leading mantissa bytes then form long runs. The compressed size
+     *          precedes the data. Requires zlib.
+     *
+     * \param   in     binary output stream providing stream()
+     * \param   data   first value
+     * \param   n      number of values
+     * \param   level  zlib compression level (1 to 9)
+     */
+    template< class BinaryInStream, class V >
+    void writeCompressedBlock ( BinaryInStream &in, const V *data, std::size_t n, int level )
+    {
+#if HAVE_ZLIB
+      const std::size_t bytes = n * sizeof( V );
+      const unsigned char *raw = reinterpret_cast< const unsigned char * >( data );
+      std::vector< Bytef > shuffled( bytes );
+      for( std::size_t i = 0; i < n; ++i )
+        for( std::size_t k = 0; k < sizeof( V ); ++k )
+          shuffled[ k*n + i ] = raw[ i*sizeof( V ) + k ];
+
+      uLongf compressedBytes = compressBound( bytes );
+      std::vector< Bytef > compressed( compressedBytes );
+      if( compress2( compressed.data(), &compressedBytes, shuffled.data(), bytes, level ) != Z_OK )
+        DUNE_THROW( IOError, "Unable to compress data block" );
+
+      in.writeUnsignedInt64( compressedBytes );
+      writeBlock( in, compressed.data(), compressedBytes );
+#else // #if HAVE_ZLIB
+      DUNE_THROW( NotImplemented, "Compressed data blocks require zlib" );
+#endif // #else // #if HAVE_ZLIB
+    }
+
+
+
+    // readCompressedBlock
+    // -------------------
+
+    /**
+     * \ingroup Other
+     * \brief read n values written by writeCompressedBlock
+     *
+     * \param   out   binary input stream providing stream()
+     * \param   data  first value
+     * \param   n     number of values
+     */
+    template< class BinaryOutStream, class V >
+    void readCompressedBlock ( BinaryOutStream &out, V *data, std::size_t n )
+    {
+#if HAVE_ZLIB
+      std::uint64_t compressedBytes;
+      out.readUnsignedInt64( compressedBytes );
+      std::vector< Bytef > compressed( compressedBytes );
+      readBlock( out, compressed.data(), compressed.size() );
+
+      const std::size_t bytes = n * sizeof( V );
+      std::vector< Bytef > shuffled( bytes );
+      uLongf length = bytes;
+      if( uncompress( shuffled.data(), &length, compressed.data(), compressed.size() ) != Z_OK || length != bytes )
+        DUNE_THROW( IOError, "Corrupt compressed data block" );
+
+      unsigned char *raw = reinterpret_cast< unsigned char * >( data );
+      for( std::size_t i = 0; i < n; ++i )
+        for( std::size_t k = 0; k < sizeof( V ); ++k )
+          raw[ i*sizeof( V ) + k ] = shuffled[ k*n + i ];
+#else // #if HAVE_ZLIB
+      DUNE_THROW( NotImplemented, "Compressed data blocks require zlib" );
+#endif // #else // #if HAVE_ZLIB
+    }
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_IO_BLOCKIO_HH
@@ -0,0 +1,123 @@
+#ifndef DUNE_VOF_IO_CELLNUMBERING_HH
+#define DUNE_VOF_IO_CELLNUMBERING_HH
+
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/common/exceptions.hh>
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // CartesianCellNumbering
+    // ----------------------
+
+    /**
+     * \ingroup Other
+     * \brief global lexicographic numbering of the cells of an axis-aligned Cartesian grid
+     * \details The bounding box and the mesh width are reduced over all ranks on construction.
+     *          The number of a cell is computed from its center and does not depend on the
+     *          partitioning, so data stored by global number can be read on any rank count.
+     *          The grid must consist of uniform, axis-aligned boxes filling its bounding box;
+     *          the constructor throws a GridError if the cell count and volume do not match.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class CartesianCellNumbering
+    {
+    public:
+      using GridView = GV;
+      using Entity = typename GridView::template Codim< 0 >::Entity;
+      using Index = std::uint64_t;
+
+      static const int dimension = GridView::dimension;
+
+    private:
+      using ctype = typename GridView::ctype;
+      using Coordinate = FieldVector< ctype, GridView::dimensionworld >;
+
+    public:
+      explicit CartesianCellNumbering ( const GridView &gridView )
+      {
+        lower_ = std::numeric_limits< ctype >::max();
+        upper_ = std::numeric_limits< ctype >::lowest();
+        h_ = std::numeric_limits< ctype >::max();
+
+        Index count = 0;
+        ctype volume = 0;
+        for( const auto &entity : elements( gridView, Partitions::interior ) )
+        {
+          const auto geometry = entity.geometry();
+          ++count;
+          volume += geometry.volume();
+          const Coordinate lower = geometry.corner( 0 );
+          const Coordinate upper = geometry.corner( geometry.corners()-1 );
+          for( int i = 0; i < dimension; ++i )
+          {
+            lower_[ i ] = std::min( lower_[ i ], lower[ i ] );
+            upper_[ i ] = std::max( upper_[ i ], upper[ i ] );
+            h_[ i ] = std::min( h_[ i ], upper[ i ] - lower[ i ] );
+          }
+        }
+
+        gridView.comm().min( &lower_[ 0 ], dimension );
+        gridView.comm().max( &upper_[ 0 ], dimension );
+        gridView.comm().min( &h_[ 0 ], dimension );
+
+        size_ = 1;
+        for( int i = 0; i < dimension; ++i )
+        {
+          cells_[ i ] = static_cast< Index >( std::round( ( upper_[ i ] - lower_[ i ] ) / h_[ i ] ) );
+          size_ *= cells_[ i ];
+        }
+
+        // the numbering is a bijection only for uniform cells filling the bounding box
+        count = gridView.comm().sum( count );
+        volume = gridView.comm().sum( volume );
+        ctype domainVolume = 1, cellVolume = 1;
+        for( int i = 0; i < dimension; ++i )
+        {
+          domainVolume *= upper_[ i ] - lower_[ i ];
+          cellVolume *= h_[ i ];
+        }
+        const ctype tolerance = 1e-8 * domainVolume;
+        if( (count != size_) || (std::abs( count * cellVolume - domainVolume ) > tolerance) || (std::abs( volume - domainVolume ) > tolerance) )
+          DUNE_THROW( GridError, "CartesianCellNumbering requires a uniform, axis-aligned Cartesian grid" );
+      }
+
+      /**
+       * \brief global number of a cell, the first coordinate runs fastest
+       */
+      Index index ( const Entity &entity ) const
+      {
+        const Coordinate center = entity.geometry().center();
+
+        Index index = 0;
+        for( int i = dimension-1; i >= 0; --i )
+          index = index * cells_[ i ] + static_cast< Index >( std::floor( ( center[ i ] - lower_[ i ] ) / h_[ i ] ) );
+        return index;
+      }
+
+      Index size () const { return size_; }
+
+    private:
+      Coordinate lower_, upper_, h_;
+      Index cells_[ dimension ];
+      Index size_;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_IO_CELLNUMBERING_HH
@@ -0,0 +1,125 @@
+#ifndef DUNE_VOF_IO_INTERFACESNAPSHOT_HH
+#define DUNE_VOF_IO_INTERFACESNAPSHOT_HH
+
+#include <cstdint>
+
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/vof/flagset.hh>
+#include <dune/vof/io/blockio.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // InterfaceSnapshot
+    // -----------------
+
+    /**
+     * \ingroup Other
+     * \brief flags, reconstructions and curvature of a snapshot in compact form
+     * \details Flags are kept for all cells, reconstructions and curvature for mixed cells only,
+     *          each in iteration order of the grid view, ghosts included. Post-processing can
+     *          scatter them back instead of recomputing them. The gathered data does not refer
+     *          to the grid, so it can be written from another thread.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    struct InterfaceSnapshot
+    {
+      using GridView = GV;
+
+      static const int dimensionworld = GridView::dimensionworld;
+
+      template< class Flags, class ReconstructionSet, class CurvatureSet >
+      void gather ( const GridView &gridView, const Flags &flags, const ReconstructionSet &reconstructions, const CurvatureSet &curvatureSet )
+      {
+        flags_.clear();
+        halfSpaces_.clear();
+        curvature_.clear();
+
+        for( const auto &entity : elements( gridView ) )
+        {
+          flags_.push_back( static_cast< std::uint8_t >( flags[ entity ] ) );
+          if( !flags.isMixed( entity ) )
+            continue;
+
+          const auto &halfSpace = reconstructions[ entity ];
+          for( int i = 0; i < dimensionworld; ++i )
+            halfSpaces_.push_back( halfSpace.innerNormal()[ i ] );
+          halfSpaces_.push_back( halfSpace.distance() );
+          curvature_.push_back( curvatureSet[ entity ] );
+        }
+      }
+
+      template< class Flags, class ReconstructionSet, class CurvatureSet >
+      void scatter ( const GridView &gridView, Flags &flags, ReconstructionSet &reconstructions, CurvatureSet &curvatureSet ) const
+      {
+        using HalfSpace = typename ReconstructionSet::DataType;
+        using Coordinate = typename HalfSpace::Coordinate;
+
+        if( flags_.size() != static_cast< std::size_t >( gridView.size( 0 ) ) )
+          DUNE_THROW( IOError, "InterfaceSnapshot holds " << flags_.size() << " cells, grid view has " << gridView.size( 0 ) );
+
+        reconstructions.clear();
+        curvatureSet.clear();
+
+        auto flag = flags_.begin();
+        auto halfSpace = halfSpaces_.begin();
+        auto curvature = curvature_.begin();
+        for( const auto &entity : elements( gridView ) )
+        {
+          flags[ entity ] = static_cast< Flag >( *flag++ );
+          if( !flags.isMixed( entity ) )
+            continue;
+
+          Coordinate normal;
+          for( int i = 0; i < dimensionworld; ++i )
+            normal[ i ] = *halfSpace++;
+          reconstructions[ entity ] = HalfSpace( normal, *halfSpace++ );
+          curvatureSet[ entity ] = *curvature++;
+        }
+      }
+
+      template< class BinaryInStream >
+      void write ( BinaryInStream &in ) const
+      {
+        in.writeUnsignedInt64( flags_.size() );
+        in.writeUnsignedInt64( curvature_.size() );
+        writeBlock( in, flags_.data(), flags_.size() );
+        writeBlock( in, halfSpaces_.data(), halfSpaces_.size() );
+        writeBlock( in, curvature_.data(), curvature_.size() );
+      }
+
+      template< class BinaryOutStream >
+      void read ( BinaryOutStream &out )
+      {
+        std::uint64_t cells, mixedCells;
+        out.readUnsignedInt64( cells );
+        out.readUnsignedInt64( mixedCells );
+
+        flags_.resize( cells );
+        halfSpaces_.resize( mixedCells * (dimensionworld+1) );
+        curvature_.resize( mixedCells );
+        readBlock( out, flags_.data(), flags_.size() );
+        readBlock( out, halfSpaces_.data(), halfSpaces_.size() );
+        readBlock( out, curvature_.data(), curvature_.size() );
+      }
+
+    private:
+      std::vector< std::uint8_t > flags_;
+      std::vector< double > halfSpaces_;
+      std::vector< double > curvature_;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_IO_INTERFACESNAPSHOT_HH
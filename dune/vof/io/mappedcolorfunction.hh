@@ -0,0 +1,186 @@
+#ifndef DUNE_VOF_IO_MAPPEDCOLORFUNCTION_HH
+#define DUNE_VOF_IO_MAPPEDCOLORFUNCTION_HH
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/vof/io/blockio.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // MappedColorFunction
+    // -------------------
+
+    /**
+     * \ingroup Other
+     * \brief read-only view of the color function in a per rank snapshot file, mapped into memory
+     * \details The header of a file written by BinaryWriter (time followed by
+     *          ColorFunction::write) is parsed through the binary stream it was written with. The
+     *          value block and, for files not in iteration order, the ordering block are mapped
+     *          with mmap and read from the mapping on access, so opening a snapshot costs no copy
+     *          and only touched pages are loaded. Only if the index set of the grid view is not in
+     *          iteration order, a table translating its indices to iteration order is built. The
+     *          view provides the read access of a DataSet and can be passed to flagging,
+     *          reconstruction and VTK output.
+     *          Only the dense, uncompressed encoding can be mapped. The view is not communicated;
+     *          per rank snapshots hold ghost values as well.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class MappedColorFunction
+    {
+      using This = MappedColorFunction< GV >;
+
+    public:
+      using GridView = GV;
+      using DataType = double;
+      using Entity = typename GridView::template Codim< 0 >::Entity;
+      using Index = typename GridView::IndexSet::IndexType;
+      using ctype = double;
+
+      /**
+       * \brief map the color function of a snapshot
+       * \details The header (time and color function header) is parsed through stream, which
+       *          must be opened on filename and positioned at its beginning. The ordering and
+       *          value blocks are taken from the mapping. On return, stream is positioned behind
+       *          the values.
+       */
+      template< class BinaryOutStream >
+      MappedColorFunction ( const GridView &gridView, const std::string &filename, BinaryOutStream &stream )
+        : gridView_( gridView )
+      {
+        std::uint64_t size;
+        bool ordered;
+        std::uint8_t encoding;
+        stream >> time_;
+        stream.readUnsignedInt64( size );
+        stream.readBool( ordered );
+        readBlock( stream, &encoding, 1 );
+
+        if( encoding != 0 )
+          DUNE_THROW( IOError, "Unable to map snapshot " << filename << ": sparse or compressed snapshots cannot be mapped" );
+        if( size != static_cast< std::uint64_t >( gridView.indexSet().size( 0 ) ) )
+          DUNE_THROW( IOError, "Unable to map snapshot " << filename << ": size does not match the grid view" );
+
+        const auto offset = stream.stream().tellg();
+        if( offset < 0 )
+          DUNE_THROW( IOError, "Unable to map snapshot " << filename << ": unknown position of values" );
+        const std::size_t valuesOffset = static_cast< std::size_t >( offset ) + ( ordered ? 0 : size * sizeof( std::uint64_t ) );
+        size_ = size;
+        bytes_ = valuesOffset + size * sizeof( double );
+
+        const int fd = open( filename.c_str(), O_RDONLY );
+        if( fd < 0 )
+          DUNE_THROW( IOError, "Unable to open snapshot " << filename );
+
+        struct stat status;
+        if( fstat( fd, &status ) != 0 )
+        {
+          close( fd );
+          DUNE_THROW( IOError, "Unable to stat snapshot " << filename );
+        }
+        length_ = status.st_size;
+        if( length_ < bytes_ )
+        {
+          close( fd );
+          DUNE_THROW( IOError, "Unable to map snapshot " << filename << ": file is truncated" );
+        }
+
+        void *data = mmap( nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0 );
+        close( fd );
+        if( data == MAP_FAILED )
+          DUNE_THROW( IOError, "Unable to map snapshot " << filename );
+        data_ = static_cast< const char * >( data );
+        ordering_ = ( ordered ? nullptr : data_ + static_cast< std::size_t >( offset ) );
+        values_ = data_ + valuesOffset;
+
+        stream.stream().seekg( bytes_ );
+
+        // translate indices of this grid view to iteration order, unless they coincide
+        std::size_t i = 0;
+        bool iterationOrdered = true;
+        for( const auto &entity : elements( gridView ) )
+          iterationOrdered &= ( gridView.indexSet().index( entity ) == i++ );
+        if( !iterationOrdered )
+        {
+          iterationOrder_.resize( size );
+          i = 0;
+          for( const auto &entity : elements( gridView ) )
+            iterationOrder_[ gridView.indexSet().index( entity ) ] = i++;
+        }
+      }
+
+      MappedColorFunction ( const This & ) = delete;
+      This &operator= ( const This & ) = delete;
+
+      ~MappedColorFunction () { unmap(); }
+
+      DataType operator[] ( const Entity &entity ) const { return (*this)[ gridView().indexSet().index( entity ) ]; }
+
+      DataType operator[] ( const Index &index ) const
+      {
+        // position in iteration order, then in the index order of the writer
+        std::uint64_t position = ( iterationOrder_.empty() ? index : iterationOrder_[ index ] );
+        if( ordering_ )
+          std::memcpy( &position, ordering_ + position * sizeof( std::uint64_t ), sizeof( std::uint64_t ) );
+        assert( position < size_ );
+
+        DataType value;
+        std::memcpy( &value, values_ + position * sizeof( DataType ), sizeof( DataType ) );
+        return value;
+      }
+
+      std::size_t size () const { return size_; }
+
+      const GridView &gridView () const { return gridView_; }
+
+      /**
+       * \brief time stamp of the snapshot
+       */
+      double time () const { return time_; }
+
+      /**
+       * \brief offset of the data following the color function in the file
+       */
+      std::size_t bytes () const { return bytes_; }
+
+    private:
+      void unmap ()
+      {
+        if( data_ )
+          munmap( const_cast< char * >( data_ ), length_ );
+        data_ = nullptr;
+      }
+
+      GridView gridView_;
+      const char *data_ = nullptr;
+      const char *ordering_ = nullptr;
+      const char *values_ = nullptr;
+      std::size_t length_ = 0, size_ = 0, bytes_ = 0;
+      double time_ = 0.0;
+      std::vector< Index > iterationOrder_;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_IO_MAPPEDCOLORFUNCTION_HH
@@ -0,0 +1,249 @@
+#ifndef DUNE_VOF_IO_SHAREDSNAPSHOT_HH
+#define DUNE_VOF_IO_SHAREDSNAPSHOT_HH
+
+#include <cstdint>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif // #if HAVE_MPI
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/vof/common/mpitraits.hh>
+#include <dune/vof/io/cellnumbering.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // SharedSnapshot
+    // --------------
+
+    /**
+     * \ingroup Other
+     * \brief one snapshot file of a color function shared by all ranks
+     * \details The file holds the time and the number of cells, followed by one double per cell
+     *          at the offset given by its global number. With MPI, all ranks write their interior
+     *          cells collectively through MPI-IO and read all their cells, including ghosts, the
+     *          same way. Since offsets do not depend on the partitioning, a snapshot can be read
+     *          on a different number of ranks. Both write and read are collective.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class SharedSnapshot
+    {
+    public:
+      using GridView = GV;
+      using Numbering = CartesianCellNumbering< GridView >;
+      using Index = typename Numbering::Index;
+
+      explicit SharedSnapshot ( const GridView &gridView )
+        : gridView_( gridView ), numbering_( gridView )
+      {}
+
+      template< class DF >
+      void write ( const std::string &filename, double time, const DF &uh ) const
+      {
+        std::vector< std::pair< Index, double > > cells;
+        for( const auto &entity : elements( gridView(), Partitions::interior ) )
+          cells.emplace_back( numbering_.index( entity ), uh[ entity ] );
+        std::sort( cells.begin(), cells.end() );
+
+        write( filename, time, cells, IsMPICommunication< typename GridView::CollectiveCommunication >() );
+      }
+
+      template< class DF >
+      double read ( const std::string &filename, DF &uh ) const
+      {
+        std::vector< std::pair< Index, double > > cells;
+        for( const auto &entity : elements( gridView(), Partitions::all ) )
+          cells.emplace_back( numbering_.index( entity ), 0.0 );
+        std::sort( cells.begin(), cells.end() );
+
+        const double time = read( filename, cells, IsMPICommunication< typename GridView::CollectiveCommunication >() );
+
+        for( const auto &entity : elements( gridView(), Partitions::all ) )
+        {
+          const auto it = std::lower_bound( cells.begin(), cells.end(), std::make_pair( numbering_.index( entity ), 0.0 ),
+                                            [] ( const auto &a, const auto &b ) { return a.first < b.first; } );
+          uh[ entity ] = it->second;
+        }
+        return time;
+      }
+
+      const GridView &gridView () const { return gridView_; }
+
+      const Numbering &numbering () const { return numbering_; }
+
+    private:
+      static const std::size_t headerSize = sizeof( double ) + sizeof( std::uint64_t );
+
+      void checkSize ( std::uint64_t size, const std::string &filename ) const
+      {
+        if( size != numbering_.size() )
+          DUNE_THROW( IOError, "Snapshot " << filename << " holds " << size << " cells, grid has " << numbering_.size() );
+      }
+
+      void write ( const std::string &filename, double time, const std::vector< std::pair< Index, double > > &cells, std::false_type ) const
+      {
+        std::vector< double > values( numbering_.size(), 0.0 );
+        for( const auto &cell : cells )
+          values[ cell.first ] = cell.second;
+
+        const std::uint64_t size = values.size();
+        std::ofstream file( filename, std::ios::binary );
+        file.write( reinterpret_cast< const char * >( &time ), sizeof( double ) );
+        file.write( reinterpret_cast< const char * >( &size ), sizeof( std::uint64_t ) );
+        file.write( reinterpret_cast< const char * >( values.data() ), values.size() * sizeof( double ) );
+        if( !file )
+          DUNE_THROW( IOError, "Unable to write snapshot " << filename );
+      }
+
+      double read ( const std::string &filename, std::vector< std::pair< Index, double > > &cells, std::false_type ) const
+      {
+        std::ifstream file( filename, std::ios::binary );
+        double time;
+        std::uint64_t size;
+        file.read( reinterpret_cast< char * >( &time ), sizeof( double ) );
+        file.read( reinterpret_cast< char * >( &size ), sizeof( std::uint64_t ) );
+        if( !file )
+          DUNE_THROW( IOError, "Unable to read snapshot " << filename );
+        checkSize( size, filename );
+
+        std::vector< double > values( size );
+        file.read( reinterpret_cast< char * >( values.data() ), values.size() * sizeof( double ) );
+        if( !file )
+          DUNE_THROW( IOError, "Unable to read snapshot " << filename );
+
+        for( auto &cell : cells )
+          cell.second = values[ cell.first ];
+        return time;
+      }
+
+#if HAVE_MPI
+      // file view selecting one double at the offset of each cell
+      static MPI_Datatype fileType ( const std::vector< std::pair< Index, double > > &cells )
+      {
+        std::vector< MPI_Aint > displacements;
+        displacements.reserve( cells.size() );
+        for( const auto &cell : cells )
+          displacements.push_back( static_cast< MPI_Aint >( cell.first * sizeof( double ) ) );
+
+        MPI_Datatype type;
+        MPI_Type_create_hindexed_block( displacements.size(), 1, displacements.data(), MPI_DOUBLE, &type );
+        MPI_Type_commit( &type );
+        return type;
+      }
+
+      // first failing call of a sequence of MPI-IO calls; file errors return their code by default
+      struct Status
+      {
+        void operator() ( int code, const char *call )
+        {
+          if( !failed && (code != MPI_SUCCESS) )
+            failed = call;
+        }
+
+        const char *failed = nullptr;
+      };
+
+      // collective, so that a failure on any rank throws on all of them
+      void check ( const Status &status, const std::string &filename ) const
+      {
+        const bool failed = gridView().comm().max( static_cast< int >( status.failed != nullptr ) );
+        if( status.failed )
+          DUNE_THROW( IOError, status.failed << " failed on snapshot " << filename );
+        if( failed )
+          DUNE_THROW( IOError, "Accessing snapshot " << filename << " failed on another rank" );
+      }
+
+      void write ( const std::string &filename, double time, const std::vector< std::pair< Index, double > > &cells, std::true_type ) const
+      {
+        MPI_Comm comm = gridView().comm();
+
+        MPI_File file;
+        if( MPI_File_open( comm, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file ) != MPI_SUCCESS )
+          DUNE_THROW( IOError, "Unable to open snapshot " << filename );
+
+        Status status;
+        // MPI_MODE_CREATE does not truncate; drop the tail of a longer previous file
+        status( MPI_File_set_size( file, 0 ), "MPI_File_set_size" );
+
+        if( gridView().comm().rank() == 0 )
+        {
+          const std::uint64_t size = numbering_.size();
+          status( MPI_File_write_at( file, 0, &time, 1, MPI_DOUBLE, MPI_STATUS_IGNORE ), "MPI_File_write_at" );
+          status( MPI_File_write_at( file, sizeof( double ), &size, 1, MPI_UINT64_T, MPI_STATUS_IGNORE ), "MPI_File_write_at" );
+        }
+
+        std::vector< double > values;
+        values.reserve( cells.size() );
+        for( const auto &cell : cells )
+          values.push_back( cell.second );
+
+        MPI_Datatype type = fileType( cells );
+        status( MPI_File_set_view( file, headerSize, MPI_DOUBLE, type, "native", MPI_INFO_NULL ), "MPI_File_set_view" );
+        status( MPI_File_write_all( file, values.data(), values.size(), MPI_DOUBLE, MPI_STATUS_IGNORE ), "MPI_File_write_all" );
+        MPI_Type_free( &type );
+
+        status( MPI_File_close( &file ), "MPI_File_close" );
+        check( status, filename );
+      }
+
+      double read ( const std::string &filename, std::vector< std::pair< Index, double > > &cells, std::true_type ) const
+      {
+        MPI_Comm comm = gridView().comm();
+
+        MPI_File file;
+        if( MPI_File_open( comm, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file ) != MPI_SUCCESS )
+          DUNE_THROW( IOError, "Unable to open snapshot " << filename );
+
+        Status status;
+        double time;
+        std::uint64_t size = 0;
+        status( MPI_File_read_at_all( file, 0, &time, 1, MPI_DOUBLE, MPI_STATUS_IGNORE ), "MPI_File_read_at_all" );
+        status( MPI_File_read_at_all( file, sizeof( double ), &size, 1, MPI_UINT64_T, MPI_STATUS_IGNORE ), "MPI_File_read_at_all" );
+        if( gridView().comm().max( static_cast< int >( status.failed || (size != numbering_.size()) ) ) )
+        {
+          MPI_File_close( &file );
+          check( status, filename );
+          checkSize( size, filename );
+          DUNE_THROW( IOError, "Snapshot " << filename << " has a different size on another rank" );
+        }
+
+        std::vector< double > values( cells.size() );
+        MPI_Datatype type = fileType( cells );
+        status( MPI_File_set_view( file, headerSize, MPI_DOUBLE, type, "native", MPI_INFO_NULL ), "MPI_File_set_view" );
+        status( MPI_File_read_all( file, values.data(), values.size(), MPI_DOUBLE, MPI_STATUS_IGNORE ), "MPI_File_read_all" );
+        MPI_Type_free( &type );
+
+        status( MPI_File_close( &file ), "MPI_File_close" );
+        check( status, filename );
+
+        for( std::size_t i = 0; i < cells.size(); ++i )
+          cells[ i ].second = values[ i ];
+        return time;
+      }
+#endif // #if HAVE_MPI
+
+      GridView gridView_;
+      Numbering numbering_;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_IO_SHAREDSNAPSHOT_HH
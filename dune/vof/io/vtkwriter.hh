@@ -0,0 +1,368 @@
+#ifndef DUNE_VOF_IO_VTKWRITER_HH
+#define DUNE_VOF_IO_VTKWRITER_HH
+
+#include <cstdint>
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif // #if HAVE_ZLIB
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dune/vof/geometry/polytope.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    namespace __impl {
+
+      template< class T >
+      struct VTKType;
+
+      template<> struct VTKType< double > { static const char *name () { return "Float64"; } };
+      template<> struct VTKType< std::int64_t > { static const char *name () { return "Int64"; } };
+      template<> struct VTKType< std::uint8_t > { static const char *name () { return "UInt8"; } };
+
+      template< class T, std::enable_if_t< std::is_enum< T >::value, int > = 0 >
+      double toDouble ( const T &value ) { return static_cast< double >( static_cast< std::underlying_type_t< T > >( value ) ); }
+
+      template< class T, std::enable_if_t< !std::is_enum< T >::value, int > = 0 >
+      double toDouble ( const T &value ) { return static_cast< double >( value ); }
+
+      inline const char *byteOrder ()
+      {
+        const std::uint16_t one = 1;
+        return ( *reinterpret_cast< const char * >( &one ) ? "LittleEndian" : "BigEndian" );
+      }
+
+      inline std::string pieceName ( int size, int rank, const std::string &name, const std::string &extension )
+      {
+        std::stringstream s;
+        s.fill( '0' );
+        s << "s" << std::setw( 4 ) << size << "-p" << std::setw( 4 ) << rank << "-" << name << "." << extension;
+        return s.str();
+      }
+
+      inline std::string collectionName ( int size, const std::string &name, const std::string &extension )
+      {
+        std::stringstream s;
+        s.fill( '0' );
+        s << "s" << std::setw( 4 ) << size << "-" << name << "." << extension;
+        return s.str();
+      }
+
+
+
+      // AppendedData
+      // ------------
+
+      // raw binary appended data section, every array preceded by a UInt64 header
+      class AppendedData
+      {
+      public:
+        explicit AppendedData ( bool compress ) : compress_( compress ) {}
+
+        template< class T >
+        void add ( std::ostream &xml, const std::string &name, int components, const std::vector< T > &values )
+        {
+          xml << "<DataArray type=\"" << VTKType< T >::name() << "\" Name=\"" << name << "\" NumberOfComponents=\"" << components
+              << "\" format=\"appended\" offset=\"" << data_.size() << "\"/>\n";
+
+          const std::uint64_t bytes = values.size() * sizeof( T );
+          const char *raw = reinterpret_cast< const char * >( values.data() );
+#if HAVE_ZLIB
+          if( compress_ )
+          {
+            uLongf compressedBytes = compressBound( bytes );
+            std::vector< Bytef > compressed( compressedBytes );
+            if( compress2( compressed.data(), &compressedBytes, reinterpret_cast< const Bytef * >( raw ), bytes, Z_DEFAULT_COMPRESSION ) != Z_OK )
+              DUNE_THROW( IOError, "Unable to compress data array " << name );
+
+            // a single block: number of blocks, block size, size of last block, compressed size
+            const std::uint64_t header[ 4 ] = { 1, bytes, bytes, compressedBytes };
+            append( header, sizeof( header ) );
+            append( compressed.data(), compressedBytes );
+            return;
+          }
+#endif // #if HAVE_ZLIB
+          append( &bytes, sizeof( bytes ) );
+          append( raw, bytes );
+        }
+
+        bool compressed () const
+        {
+#if HAVE_ZLIB
+          return compress_;
+#else // #if HAVE_ZLIB
+          return false;
+#endif // #else // #if HAVE_ZLIB
+        }
+
+        void write ( std::ostream &out ) const
+        {
+          out << "<AppendedData encoding=\"raw\">\n_";
+          out.write( data_.data(), data_.size() );
+          out << "\n</AppendedData>\n";
+        }
+
+      private:
+        void append ( const void *data, std::size_t bytes )
+        {
+          const char *begin = static_cast< const char * >( data );
+          data_.insert( data_.end(), begin, begin + bytes );
+        }
+
+        bool compress_;
+        std::vector< char > data_;
+      };
+
+
+
+      inline void writeVTKFile ( const std::string &filename, const std::string &type, const std::string &content, const AppendedData &appended )
+      {
+        std::ofstream file( filename, std::ios::binary );
+        file << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"" << type << "\" version=\"1.0\" byte_order=\"" << byteOrder() << "\" header_type=\"UInt64\"";
+        if( appended.compressed() )
+          file << " compressor=\"vtkZLibDataCompressor\"";
+        file << ">\n" << content;
+        appended.write( file );
+        file << "</VTKFile>\n";
+        if( !file )
+          DUNE_THROW( IOError, "Unable to write " << filename );
+      }
+
+      // parallel header referencing the pieces of all ranks
+      inline void writeParallelFile ( const std::string &path, const std::string &name, const std::string &type, const std::string &extension,
+                                      int size, const std::vector< std::string > &cellData )
+      {
+        std::ofstream file( path + "/" + collectionName( size, name, "p" + extension ) );
+        file << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"P" << type << "\" version=\"1.0\" byte_order=\"" << byteOrder() << "\" header_type=\"UInt64\">\n"
+             << "<P" << type << " GhostLevel=\"0\">\n"
+             << "<PPointData>\n</PPointData>\n"
+             << "<PCellData>\n";
+        for( const auto &data : cellData )
+          file << "<PDataArray type=\"Float64\" Name=\"" << data << "\" NumberOfComponents=\"1\"/>\n";
+        file << "</PCellData>\n"
+             << "<PPoints>\n<PDataArray type=\"Float64\" Name=\"Coordinates\" NumberOfComponents=\"3\"/>\n</PPoints>\n";
+        for( int rank = 0; rank < size; ++rank )
+          file << "<Piece Source=\"" << pieceName( size, rank, name, extension ) << "\"/>\n";
+        file << "</P" << type << ">\n</VTKFile>\n";
+        if( !file )
+          DUNE_THROW( IOError, "Unable to write parallel VTK file for " << name );
+      }
+
+    } // namespace __impl
+
+
+
+    // VTUWriter
+    // ---------
+
+    /**
+     * \ingroup Other
+     * \brief VTU output of cell data with raw binary appended data
+     * \details Each rank writes its interior cells to one piece, rank 0 adds the parallel
+     *          header. File names follow Dune::VTKWriter::pwrite. If zlib is available, data
+     *          arrays may be compressed. Cell data is read through operator[] when writing, so
+     *          the writer can be set up once and used in the time loop.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class VTUWriter
+    {
+    public:
+      using GridView = GV;
+      using Entity = typename GridView::template Codim< 0 >::Entity;
+
+      static const int dimension = GridView::dimension;
+
+      explicit VTUWriter ( const GridView &gridView, bool compress = false )
+        : gridView_( gridView ), compress_( compress )
+      {}
+
+      template< class Data >
+      void addCellData ( const Data &data, const std::string &name )
+      {
+        cellData_.emplace_back( name, [ &data ] ( const Entity &entity ) { return __impl::toDouble( data[ entity ] ); } );
+      }
+
+      void write ( const std::string &path, const std::string &name ) const
+      {
+        const auto &indexSet = gridView_.indexSet();
+
+        // vertices of the grid view, padded to three components
+        std::vector< double > points( 3 * indexSet.size( dimension ), 0.0 );
+        std::vector< std::int64_t > connectivity, offsets;
+        std::vector< std::uint8_t > types;
+        std::vector< std::vector< double > > cellData( cellData_.size() );
+
+        for( const auto &entity : elements( gridView_, Partitions::interior ) )
+        {
+          const auto geometry = entity.geometry();
+          for( int i = 0; i < geometry.corners(); ++i )
+          {
+            const auto index = indexSet.subIndex( entity, vtkCorner( i ), dimension );
+            const auto corner = geometry.corner( vtkCorner( i ) );
+            for( int k = 0; k < corner.size(); ++k )
+              points[ 3*index + k ] = corner[ k ];
+            connectivity.push_back( index );
+          }
+          offsets.push_back( connectivity.size() );
+          types.push_back( vtkType() );
+
+          for( std::size_t k = 0; k < cellData_.size(); ++k )
+            cellData[ k ].push_back( cellData_[ k ].second( entity ) );
+        }
+
+        __impl::AppendedData appended( compress_ );
+        std::stringstream xml;
+        xml << "<UnstructuredGrid>\n"
+            << "<Piece NumberOfPoints=\"" << indexSet.size( dimension ) << "\" NumberOfCells=\"" << types.size() << "\">\n"
+            << "<CellData>\n";
+        for( std::size_t k = 0; k < cellData_.size(); ++k )
+          appended.add( xml, cellData_[ k ].first, 1, cellData[ k ] );
+        xml << "</CellData>\n<Points>\n";
+        appended.add( xml, "Coordinates", 3, points );
+        xml << "</Points>\n<Cells>\n";
+        appended.add( xml, "connectivity", 1, connectivity );
+        appended.add( xml, "offsets", 1, offsets );
+        appended.add( xml, "types", 1, types );
+        xml << "</Cells>\n</Piece>\n</UnstructuredGrid>\n";
+
+        const int size = gridView_.comm().size(), rank = gridView_.comm().rank();
+        __impl::writeVTKFile( path + "/" + __impl::pieceName( size, rank, name, "vtu" ), "UnstructuredGrid", xml.str(), appended );
+
+        if( rank == 0 )
+        {
+          std::vector< std::string > names;
+          for( const auto &data : cellData_ )
+            names.push_back( data.first );
+          __impl::writeParallelFile( path, name, "UnstructuredGrid", "vtu", size, names );
+        }
+      }
+
+    private:
+      // VTK numbers the corners of quadrilaterals and hexahedra counterclockwise
+      static int vtkCorner ( int i ) { return ( ( i & 2 ) ? ( i ^ 1 ) : i ); }
+
+      static std::uint8_t vtkType () { return ( dimension == 1 ? 3 : ( dimension == 2 ? 9 : 12 ) ); }
+
+      GridView gridView_;
+      bool compress_;
+      std::vector< std::pair< std::string, std::function< double( const Entity & ) > > > cellData_;
+    };
+
+
+
+    // InterfaceVTPWriter
+    // ------------------
+
+    /**
+     * \ingroup Other
+     * \brief VTP output of the reconstructed interface with raw binary appended data
+     * \details The interface of every interior mixed cell is written as a line (2d) or polygon
+     *          (3d). Cell data refers to the host cells. Each rank writes one piece, rank 0 adds
+     *          the parallel header.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class InterfaceVTPWriter
+    {
+    public:
+      using GridView = GV;
+      using Entity = typename GridView::template Codim< 0 >::Entity;
+
+      explicit InterfaceVTPWriter ( const GridView &gridView, bool compress = false )
+        : gridView_( gridView ), compress_( compress )
+      {}
+
+      template< class Data >
+      void addCellData ( const Data &data, const std::string &name )
+      {
+        cellData_.emplace_back( name, [ &data ] ( const Entity &entity ) { return __impl::toDouble( data[ entity ] ); } );
+      }
+
+      template< class ReconstructionSet, class Flags >
+      void write ( const std::string &path, const std::string &name, const ReconstructionSet &reconstructions, const Flags &flags ) const
+      {
+        std::vector< double > points;
+        std::vector< std::int64_t > connectivity, offsets;
+        std::vector< std::vector< double > > cellData( cellData_.size() );
+
+        for( const auto &entity : elements( gridView_, Partitions::interior ) )
+        {
+          if( !flags.isMixed( entity ) )
+            continue;
+
+          const auto polytope = interface( entity, reconstructions );
+          for( std::size_t i = 0; i < static_cast< std::size_t >( polytope.size() ); ++i )
+          {
+            const auto vertex = polytope.vertex( i );
+            connectivity.push_back( points.size() / 3 );
+            for( int k = 0; k < 3; ++k )
+              points.push_back( k < vertex.size() ? vertex[ k ] : 0.0 );
+          }
+          offsets.push_back( connectivity.size() );
+
+          for( std::size_t k = 0; k < cellData_.size(); ++k )
+            cellData[ k ].push_back( cellData_[ k ].second( entity ) );
+        }
+
+        const char *cells = ( GridView::dimensionworld == 2 ? "Lines" : "Polys" );
+
+        __impl::AppendedData appended( compress_ );
+        std::stringstream xml;
+        xml << "<PolyData>\n"
+            << "<Piece NumberOfPoints=\"" << points.size() / 3 << "\" NumberOfVerts=\"0\" NumberOfLines=\"" << ( GridView::dimensionworld == 2 ? offsets.size() : 0 )
+            << "\" NumberOfStrips=\"0\" NumberOfPolys=\"" << ( GridView::dimensionworld == 2 ? 0 : offsets.size() ) << "\">\n"
+            << "<CellData>\n";
+        for( std::size_t k = 0; k < cellData_.size(); ++k )
+          appended.add( xml, cellData_[ k ].first, 1, cellData[ k ] );
+        xml << "</CellData>\n<Points>\n";
+        appended.add( xml, "Coordinates", 3, points );
+        xml << "</Points>\n<" << cells << ">\n";
+        appended.add( xml, "connectivity", 1, connectivity );
+        appended.add( xml, "offsets", 1, offsets );
+        xml << "</" << cells << ">\n</Piece>\n</PolyData>\n";
+
+        const int size = gridView_.comm().size(), rank = gridView_.comm().rank();
+        __impl::writeVTKFile( path + "/" + __impl::pieceName( size, rank, name, "vtp" ), "PolyData", xml.str(), appended );
+
+        if( rank == 0 )
+        {
+          std::vector< std::string > names;
+          for( const auto &data : cellData_ )
+            names.push_back( data.first );
+          __impl::writeParallelFile( path, name, "PolyData", "vtp", size, names );
+        }
+      }
+
+    private:
+      GridView gridView_;
+      bool compress_;
+      std::vector< std::pair< std::string, std::function< double( const Entity & ) > > > cellData_;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_IO_VTKWRITER_HH
@@ -4,7 +4,9 @@
 #include <cassert>
 #include <cstddef>
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
 #include <vector>
 
 #include <dune/grid/common/mcmgmapper.hh>
@@ -58,6 +60,17 @@ namespace Dune
 
       Index size () const { return size_; }
 
+      /**
+       * \brief index of a cell given by its index in the element mapper, or invalidIndex() if it
+       *        is not mixed
+       * \note  For grid views with a single geometry type, this is the index in the index set.
+       */
+      Index operator[] ( std::size_t elementIndex ) const
+      {
+        assert( elementIndex < indices_.size() );
+        return indices_[ elementIndex ];
+      }
+
       template< class Entity >
       bool contains ( const Entity &entity, Index &index ) const
       {
@@ -85,9 +98,73 @@ namespace Dune
           indices_[ elementMapper_.index( element ) ] = (flags.isMixed( element ) ? size_++ : invalidIndex());
       }
 
-    private:
+      /**
+       * \brief update the mixed cells, keeping the index of each cell that stays mixed where possible
+       * \details Cells that became mixed take the indices of cells that are no longer mixed. If
+       *          fewer cells became mixed, the highest indices are moved into the remaining gaps,
+       *          so indices stay consecutive. On return, origin holds the previous index for each
+       *          index, or invalidIndex() for cells that became mixed. The grid view must not have
+       *          changed since the last update.
+       */
+      void update ( const FlagSet< GridView > &flags, std::vector< Index > &origin )
+      {
+        origin.resize( size_ );
+        std::iota( origin.begin(), origin.end(), Index( 0 ) );
+
+        std::vector< Index > freed;
+        std::vector< ElementIndex > added;
+        for( const auto &element : elements( flags.gridView(), Partitions::all ) )
+        {
+          const ElementIndex elementIndex = elementMapper_.index( element );
+          Index &index = indices_[ elementIndex ];
+          if( flags.isMixed( element ) )
+          {
+            if( index == invalidIndex() )
+              added.push_back( elementIndex );
+          }
+          else if( index != invalidIndex() )
+          {
+            freed.push_back( index );
+            origin[ index ] = invalidIndex();
+            index = invalidIndex();
+          }
+        }
+
+        for( const ElementIndex elementIndex : added )
+        {
+          if( freed.empty() )
+          {
+            indices_[ elementIndex ] = origin.size();
+            origin.push_back( invalidIndex() );
+          }
+          else
+          {
+            indices_[ elementIndex ] = freed.back();
+            freed.pop_back();
+          }
+        }
+
+        // close remaining gaps with the highest indices
+        const Index size = origin.size() - freed.size();
+        std::sort( freed.begin(), freed.end() );
+        auto gap = freed.begin();
+        for( Index &index : indices_ )
+        {
+          if( (index == invalidIndex()) || (index < size) )
+            continue;
+          assert( (gap != freed.end()) && (*gap < size) );
+          origin[ *gap ] = origin[ index ];
+          index = *gap++;
+        }
+
+        origin.resize( size );
+        size_ = size;
+      }
+
       static constexpr Index invalidIndex () noexcept { return std::numeric_limits< Index >::max(); }
 
+    private:
+
       ElementMapper elementMapper_;
       std::vector< Index > indices_;
       Index size_;
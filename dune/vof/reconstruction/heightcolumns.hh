@@ -0,0 +1,197 @@
+#ifndef DUNE_VOF_RECONSTRUCTION_HEIGHTCOLUMNS_HH
+#define DUNE_VOF_RECONSTRUCTION_HEIGHTCOLUMNS_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <dune/vof/stencil/heightfunctionstencil.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // HeightColumns
+    // -------------
+
+    /**
+     * \ingroup Reconstruction
+     * \brief   cache of height function columns
+     * \details A column is identified by its base cell and the orientation of the stencil. It
+     *          stores the color of the base cell and the partial sums upwards and downwards for
+     *          up to tup cells, the height of the stencil that computed it, so lower stencils can
+     *          share it; a higher stencil recomputes the column and replaces it. Neighboring
+     *          mixed cells evaluate overlapping columns, which are summed up once.
+     *
+     *          Columns are kept across applications: update compares the color function with
+     *          a copy taken by the previous update and drops only the columns that read a
+     *          changed cell, so columns away from the moving part of the interface are not
+     *          summed again. During a threaded sweep, the kept columns are only read; each
+     *          thread inserts into a map of its own and merge collects them afterwards.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class HeightColumns
+    {
+    public:
+      using GridView = GV;
+
+      static constexpr int dim = GridView::dimension;
+      static constexpr int maxTup = HeightFunctionStencil< GridView >::maxTup;
+
+      struct Column
+      {
+        double height ( int tup ) const
+        {
+          assert( tup <= this->tup );
+          return (tup > 0 ? base + up[ tup-1 ] + down[ tup-1 ] : base);
+        }
+
+        int tup = 0;
+        double base = 0.0;
+        std::array< double, maxTup > up = {}, down = {};
+
+        // cells read, center + t * step for first <= t <= last
+        std::size_t center = 0;
+        long step = 0;
+        int first = 0, last = -1;
+      };
+
+      // multi index of the base cell and orientation
+      using Key = std::array< int, dim+1 >;
+
+      HeightColumns () : columns_( 1 ) {}
+
+      /**
+       * \brief remove all columns and prepare maps for the given number of threads
+       */
+      void clear ( std::size_t threads = 1 )
+      {
+        kept_.clear();
+        previous_.clear();
+        prepare( threads );
+      }
+
+      /**
+       * \brief drop the columns that read cells changed since the last update and prepare maps
+       *        for the given number of threads
+       */
+      template< class ColorFunction >
+      void update ( const ColorFunction &color, std::size_t threads = 1 )
+      {
+        merge();
+
+        if( previous_.size() != color.size() )
+          kept_.clear();
+        else
+        {
+          std::vector< bool > changed( color.size(), false );
+          bool any = false;
+          for( std::size_t i = 0; i < color.size(); ++i )
+            if( previous_[ i ] != static_cast< double >( color[ i ] ) )
+              changed[ i ] = any = true;
+
+          for( auto pos = kept_.begin(); any && (pos != kept_.end()); )
+          {
+            if( reads( pos->second, changed ) )
+              pos = kept_.erase( pos );
+            else
+              ++pos;
+          }
+        }
+
+        previous_.assign( color.begin(), color.end() );
+        prepare( threads );
+      }
+
+      /**
+       * \brief move columns inserted by the threads into the kept columns
+       */
+      void merge ()
+      {
+        for( const auto &columns : columns_ )
+          for( const auto &column : columns )
+          {
+            auto result = kept_.insert( column );
+            if( !result.second && (result.first->second.tup < column.second.tup) )
+              result.first->second = column.second;
+          }
+        prepare( 1 );
+      }
+
+      /**
+       * \brief return the column for key with sums up to tup, computing it with compute() on a
+       *        miss or if the cached column is too short
+       */
+      template< class F >
+      const Column &operator() ( const Key &key, int tup, std::size_t thread, F &&compute )
+      {
+        auto &columns = columns_[ thread ];
+        auto pos = columns.find( key );
+        if( pos != columns.end() )
+        {
+          if( pos->second.tup < tup )
+            pos->second = compute();
+          return pos->second;
+        }
+
+        const auto kept = kept_.find( key );
+        if( (kept != kept_.end()) && (kept->second.tup >= tup) )
+          return kept->second;
+        return columns.emplace( key, compute() ).first->second;
+      }
+
+      std::size_t size () const
+      {
+        std::size_t size = kept_.size();
+        for( const auto &columns : columns_ )
+          size += columns.size();
+        return size;
+      }
+
+    private:
+      struct Hash
+      {
+        std::size_t operator() ( const Key &key ) const
+        {
+          std::size_t hash = 0;
+          for( int k : key )
+            hash = hash * 1000003u ^ std::hash< int >()( k );
+          return hash;
+        }
+      };
+
+      using Map = std::unordered_map< Key, Column, Hash >;
+
+      void prepare ( std::size_t threads )
+      {
+        columns_.resize( std::max( threads, std::size_t( 1 ) ) );
+        for( auto &columns : columns_ )
+          columns.clear();
+      }
+
+      static bool reads ( const Column &column, const std::vector< bool > &changed )
+      {
+        for( int t = column.first; t <= column.last; ++t )
+          if( changed[ static_cast< std::size_t >( static_cast< long >( column.center ) + t * column.step ) ] )
+            return true;
+        return false;
+      }
+
+      Map kept_;
+      std::vector< Map > columns_;
+      std::vector< double > previous_;
+    };
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_RECONSTRUCTION_HEIGHTCOLUMNS_HH
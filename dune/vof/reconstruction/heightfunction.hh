@@ -1,18 +1,22 @@
 #ifndef DUNE_VOF_RECONSTRUCTION_HEIGHTFUNCTION_HH
 #define DUNE_VOF_RECONSTRUCTION_HEIGHTFUNCTION_HH
 
+#include <cassert>
 #include <cmath>
 
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include <dune/common/fmatrix.hh>
 
 #include <dune/vof/dataset.hh>
 #include <dune/vof/utility.hh>
+#include <dune/vof/common/threadpartition.hh>
 #include <dune/vof/geometry/algorithm.hh>
 #include <dune/vof/geometry/polytope.hh>
 #include <dune/vof/geometry/utility.hh>
+#include <dune/vof/reconstruction/heightcolumns.hh>
 
 #include <dune/vof/stencil/heightfunctionstencil.hh>
 
@@ -52,10 +56,23 @@ namespace Dune
       using Orientation = std::tuple< int, int >;
 
     public:
-      explicit HeightFunctionReconstruction ( const StencilSet &vertexStencilSet )
-       : vertexStencilSet_( vertexStencilSet ), initializer_( vertexStencilSet ), satisfiesConstraint_( vertexStencilSet_.gridView() )
+      using Columns = HeightColumns< GridView >;
+
+      /**
+       * \brief   constructor
+       * \details Pass the columns of another height function operator to share them, e.g.,
+       *          with CartesianHeightFunctionCurvature applied to the same color function.
+       */
+      explicit HeightFunctionReconstruction ( const StencilSet &vertexStencilSet, std::shared_ptr< Columns > columns = nullptr )
+       : vertexStencilSet_( vertexStencilSet ), initializer_( vertexStencilSet ), satisfiesConstraint_( vertexStencilSet_.gridView() ),
+         columns_( columns ? std::move( columns ) : std::make_shared< Columns >() )
       {}
 
+      /**
+       * \brief   height columns, kept across applications as long as their cells do not change
+       */
+      const std::shared_ptr< Columns > &columns () const { return columns_; }
+
       /**
        * \brief   (global) operator application
        *
@@ -71,6 +88,7 @@ namespace Dune
                         bool communicate = true ) const
       {
         initializer_( color, reconstructions, flags );
+        columns_->update( color );
 
         for ( const auto &entity : elements( color.gridView(), Partitions::interiorBorder ) )
         {
@@ -86,6 +104,30 @@ namespace Dune
           reconstructions.communicate();
       }
 
+      /**
+       * \brief   (global) operator application on several threads
+       * \details \see ThreadPartition
+       */
+      template< class ColorFunction, class ReconstructionSet, class Flags >
+      void operator() ( const ColorFunction &color, ReconstructionSet &reconstructions, const Flags &flags,
+                        const ThreadPartition< GridView > &threads, bool communicate = true ) const
+      {
+        initializer_( color, reconstructions, flags, threads );
+        columns_->update( color, threads.size() );
+
+        threads.forEach( [ this, &color, &reconstructions, &flags ] ( std::size_t thread, const Entity &entity ) {
+            if ( !flags.isMixed( entity ) )
+              return;
+
+            satisfiesConstraint_[ entity ] = 0;
+            applyLocal( entity, color, flags, reconstructions[ entity ], thread );
+          } );
+        columns_->merge();
+
+        if ( communicate )
+          reconstructions.communicate();
+      }
+
       /**
        * \brief   (local) operator application
        *
@@ -96,9 +138,11 @@ namespace Dune
        * \param   color           color functions
        * \param   flags           set of flags
        * \param   reconstruction  single reconstruction
+       * \param   thread          thread calling, selects the map of height columns
        */
       template< class ColorFunction, class Flags, class Reconstruction >
-      void applyLocal ( const Entity &entity, const ColorFunction &color, const Flags &flags, Reconstruction &reconstruction ) const
+      void applyLocal ( const Entity &entity, const ColorFunction &color, const Flags &flags, Reconstruction &reconstruction,
+                        std::size_t thread = 0 ) const
       {
         const Coordinate &normal = reconstruction.innerNormal();
         const Orientation orientation = getOrientation( normal );
@@ -106,7 +150,7 @@ namespace Dune
         const auto entityInfo = GridView::Grid::getRealImplementation( entity ).entityInfo();
         const auto stencil = Stencil( color.gridView(), entityInfo, orientation );
 
-        Heights heights = getHeightValues( color, stencil );
+        Heights heights = getHeightValues( color, stencil, thread );
 
         /*
         // Check constraint
@@ -144,55 +188,94 @@ namespace Dune
       }
 
       template< class ColorFunction, class Stencil >
-      Heights getHeightValues ( const ColorFunction &color, const Stencil &stencil ) const
+      Heights getHeightValues ( const ColorFunction &color, const Stencil &stencil, std::size_t thread = 0 ) const
       {
+        assert( stencil.tup() <= Columns::maxTup );
+
         Heights heights( 0.0 );
+        for( std::size_t i = 0; i < stencil.columns(); ++i )
+        {
+          typename Columns::Key key;
+          const auto base = stencil.template getMultiIndex< dim >( i, 0 );
+          for( int k = 0; k < dim; ++k )
+            key[ k ] = base[ k ];
+          key[ dim ] = 2 * std::get< 0 >( stencil.orientation() ) + ( std::get< 1 >( stencil.orientation() ) > 0 ? 1 : 0 );
+
+          heights[ i ] = (*columns_)( key, stencil.tup(), thread, [ &color, &stencil, i ] () { return getColumn( color, stencil, i ); } ).height( stencil.tup() );
+        }
+        return heights;
+      }
+
+      // sum up column i of the stencil for all heights up to the height of the stencil
+      template< class ColorFunction, class Stencil >
+      static typename Columns::Column getColumn ( const ColorFunction &color, const Stencil &stencil, std::size_t i )
+      {
+        typename Columns::Column column;
+        column.tup = stencil.tup();
 
         const double TOL = 1e-10;
 
-        for( std::size_t i = 0; i < stencil.columns(); ++i )
-        {
-          if ( !stencil.valid( i, 0 ) )
-            continue;
+        if ( !stencil.valid( i, 0 ) )
+          return column;
 
-          double u0 = clamp( color[ stencil( i, 0 ) ], 0.0, 1.0 );
-          heights[ i ] += u0;
+        column.center = stencil.index( i, 0 );
+        column.step = stencil.step();
+        column.first = column.last = 0;
 
-          // upwards
-          double lastU = u0;
+        double u0 = clamp( color[ column.center ], 0.0, 1.0 );
+        column.base = u0;
 
-          for( int t = 1; t <= stencil.tup(); ++t )
-          {
-            if ( !stencil.valid( i, t ) )
-              break;
+        // upwards
+        double lastU = u0;
+        double sum = 0.0;
+        bool stop = false;
 
-            double u = clamp( color[ stencil( i, t ) ], 0.0, 1.0 );
+        for( int t = 1; t <= column.tup; ++t )
+        {
+          if ( !stop && !stencil.valid( i, t ) )
+            stop = true;
 
-            if ( u > lastU - TOL  && !( u > 1.0 - TOL ) )
-              break;
+          if ( !stop )
+          {
+            double u = clamp( color[ stencil.index( i, t ) ], 0.0, 1.0 );
+            column.last = t;
 
-            heights[ i ] += u;
-            lastU = u;
+            if ( u > lastU - TOL  && !( u > 1.0 - TOL ) )
+              stop = true;
+            else
+            {
+              sum += u;
+              lastU = u;
+            }
           }
+          column.up[ t-1 ] = sum;
+        }
 
-          lastU = u0;
+        lastU = u0;
+        sum = 0.0;
+        stop = false;
 
-          // downwards
-          for( int t = -1; t >= stencil.tdown(); --t )
-          {
-            if ( !stencil.valid( i, t ) )
-              break;
+        // downwards
+        for( int t = 1; t <= column.tup; ++t )
+        {
+          if ( !stop && !stencil.valid( i, -t ) )
+            stop = true;
 
-            double u = clamp( color[ stencil( i, t ) ], 0.0, 1.0 );
+          if ( !stop )
+          {
+            double u = clamp( color[ stencil.index( i, -t ) ], 0.0, 1.0 );
+            column.first = -t;
 
             if ( u < lastU + TOL && !( u < TOL ) )
               u = 1.0;
 
-            heights[ i ] += u;
+            sum += u;
             lastU = u;
           }
+          column.down[ t-1 ] = sum;
         }
-        return heights;
+
+        return column;
       }
 
     private:
@@ -283,7 +366,9 @@ namespace Dune
 
       const StencilSet &vertexStencilSet_;
       InitialReconstruction initializer_;
+      // only written for the element under consideration, so distinct elements may be processed concurrently
       mutable Dune::VoF::DataSet< GridView, std::size_t > satisfiesConstraint_;
+      std::shared_ptr< Columns > columns_;
     };
 
   }       // end of namespace VoF
@@ -10,6 +10,7 @@
 
 #include <dune/grid/common/partitionset.hh>
 
+#include <dune/vof/common/threadpartition.hh>
 #include <dune/vof/geometry/algorithm.hh>
 #include <dune/vof/geometry/utility.hh>
 #include <dune/vof/utility.hh>
@@ -75,6 +76,24 @@ namespace Dune
           reconstructions.communicate();
       }
 
+      /**
+       * \brief   (global) operator application on several threads
+       * \details \see ThreadPartition
+       */
+      template< class ColorFunction, class ReconstructionSet, class Flags >
+      void operator() ( const ColorFunction &color, ReconstructionSet &reconstructions, const Flags &flags,
+                        const ThreadPartition< GridView > &threads, bool communicate = true ) const
+      {
+        reconstructions.clear();
+        threads.forEach( [ this, &color, &reconstructions, &flags ] ( std::size_t, const Entity &entity ) {
+            if ( flags.isMixed( entity ) )
+              applyLocal( entity, color, flags, reconstructions[ entity ] );
+          } );
+
+        if ( communicate )
+          reconstructions.communicate();
+      }
+
       /**
        * \brief   (local) operator application
        *
@@ -1,7 +1,24 @@
 #ifndef DUNE_VOF_RECONSTRUCTIONSET_HH
 #define DUNE_VOF_RECONSTRUCTIONSET_HH
 
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+
+#include <dune/vof/common/mpitraits.hh>
+#include <dune/vof/common/persistentexchange.hh>
 #include <dune/vof/dataset.hh>
+#include <dune/vof/flagset.hh>
+#include <dune/vof/mixedcellmapper.hh>
 #include <dune/vof/geometry/halfspace.hh>
 
 
@@ -17,11 +34,202 @@ namespace Dune
     /**
      * \ingroup Other
      * \brief set of reconstructions
+     * \details A storage type different from the grid's coordinate type (e.g., float) stores
+     *          smaller half spaces. They convert from and to the half spaces computed by the
+     *          reconstruction operators, \see HalfSpace.
      *
      * \tparam  GridView  grid view
+     * \tparam  T         storage type of normal and distance
      */
-    template< class GridView >
-    using ReconstructionSet = DataSet< GridView, HalfSpace< typename GridView::template Codim< 0 >::Geometry::GlobalCoordinate > >;
+    template< class GridView, class T = typename GridView::ctype >
+    using ReconstructionSet = DataSet< GridView, HalfSpace< FieldVector< T, GridView::dimensionworld > > >;
+
+
+
+
+    // SparseReconstructionSet
+    // -----------------------
+
+    /**
+     * \ingroup Other
+     * \brief set of reconstructions stored for mixed cells only
+     * \details The reconstructions are indexed through a MixedCellMapper, so the storage of the
+     *          half spaces and the cost of clear() scale with the number of interface cells.
+     *          The mapper itself still holds one index per cell and update() walks the whole
+     *          grid, just like the flags it is computed from. Reading the reconstruction of a
+     *          non-mixed cell yields an empty half space; writing it raises a RangeError.
+     *          update() has to be called after each flagging. Communication sends a message of
+     *          fixed size per cell, the half space and whether the cell is mixed, so it reuses
+     *          the persistent exchanges of DataSet although the mixed cells change every step.
+     *
+     * \tparam  GV  grid view
+     */
+    template< class GV >
+    class SparseReconstructionSet
+    {
+      using This = SparseReconstructionSet< GV >;
+
+    public:
+      using GridView = GV;
+      using Flags = FlagSet< GridView >;
+      using DataType = HalfSpace< FieldVector< typename GridView::ctype, GridView::dimensionworld > >;
+      using Entity = typename GridView::template Codim< 0 >::Entity;
+      using Indices = MixedCellMapper< GridView >;
+      using Index = typename Indices::Index;
+
+      using iterator = typename std::vector< DataType >::iterator;
+      using const_iterator = typename std::vector< DataType >::const_iterator;
+
+      /**
+       * \brief MPI communication handler
+       */
+      struct Exchange;
+
+      explicit SparseReconstructionSet ( const Flags &flags )
+        : flags_( flags ), indices_( flags ), dataSet_( indices_.size() )
+      {}
+
+      const DataType& operator[] ( const Entity &entity ) const
+      {
+        Index index;
+        indices_.contains( entity, index );
+        return ( index < dataSet_.size() ? dataSet_[ index ] : empty() );
+      }
+
+      DataType& operator[] ( const Entity &entity )
+      {
+        Index index;
+        indices_.contains( entity, index );
+        if( index >= dataSet_.size() )
+          DUNE_THROW( RangeError, "SparseReconstructionSet stores no reconstruction for cells that are not mixed" );
+        return dataSet_[ index ];
+      }
+
+      iterator begin () { return dataSet_.begin(); }
+      iterator end () { return dataSet_.end(); }
+
+      const_iterator begin () const { return dataSet_.begin(); }
+      const_iterator end () const { return dataSet_.end(); }
+
+      /**
+       * \brief renumber the mixed cells after the flags have changed
+       */
+      void update ()
+      {
+        indices_.update( flags() );
+        dataSet_.resize( indices_.size() );
+      }
+
+      void clear() { std::fill( dataSet_.begin(), dataSet_.end(), DataType() ); }
+
+      std::size_t size() const { return dataSet_.size(); }
+
+      void communicate ()
+      {
+        communicate( IsMPICommunication< typename GridView::CollectiveCommunication >() );
+      }
+
+      const GridView &gridView () const { return flags().gridView(); }
+
+      const Flags &flags () const { return flags_; }
+      const Indices &indices () const { return indices_; }
+
+    private:
+      // reconstruction of a cell and whether the sender stores one
+      struct Message
+      {
+        DataType reconstruction;
+        std::uint8_t mixed;
+      };
+
+      Message message ( Index index ) const
+      {
+        return ( index < dataSet_.size() ? Message{ dataSet_[ index ], 1 } : Message{ DataType(), 0 } );
+      }
+
+      void assign ( Index index, const Message &message )
+      {
+        if( message.mixed && ( index < dataSet_.size() ) )
+          dataSet_[ index ] = message.reconstruction;
+      }
+
+      void communicate ( std::false_type )
+      {
+        Exchange exchange( *this );
+        gridView().communicate( exchange, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication );
+      }
+
+#if HAVE_MPI
+      void communicate ( std::true_type )
+      {
+        // the communication plan is given in terms of the index set
+        assert( gridView().indexSet().types( 0 ).size() == 1u );
+        exchanges_( gridView(), Dune::InteriorBorder_All_Interface ).exchange(
+            [ this ] ( const auto &index ) { return message( indices_[ index ] ); },
+            [ this ] ( const auto &index, const Message &received ) { assign( indices_[ index ], received ); } );
+      }
+
+      PersistentExchanges< GridView, Message > exchanges_;
+#endif // #if HAVE_MPI
+
+      static const DataType &empty ()
+      {
+        static const DataType empty;
+        return empty;
+      }
+
+      const Flags &flags_;
+      Indices indices_;
+      std::vector< DataType > dataSet_;
+    };
+
+
+
+    // Exchange class for grids without MPI communicator
+    // Each cell sends the same message as through the persistent exchange; only mixed cells
+    // carry a reconstruction.
+    template< class GV >
+    struct SparseReconstructionSet< GV >::Exchange
+      : public Dune::CommDataHandleIF< Exchange, Message >
+    {
+      explicit Exchange ( SparseReconstructionSet &dataSet ) : dataSet_( dataSet ) {}
+
+      bool contains ( int dim, int codim ) const { return ( codim == 0 ); }
+
+      bool fixedsize ( int dim, int codim ) const { return true; }
+
+      template < class Entity >
+      std::size_t size ( const Entity &e ) const { return 1; }
+
+      template < class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension == 0, int > = 0 >
+      void gather ( MessageBuffer &buff, const Entity &e ) const
+      {
+        Index index;
+        dataSet_.indices().contains( e, index );
+        buff.write( dataSet_.message( index ) );
+      }
+
+      template < class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension != 0, int > = 0 >
+      void gather ( MessageBuffer &buff, const Entity &e ) const
+      {}
+
+      template < class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension == 0, int > = 0 >
+      void scatter ( MessageBuffer &buff, const Entity &e, std::size_t n )
+      {
+        Message message;
+        buff.read( message );
+        Index index;
+        dataSet_.indices().contains( e, index );
+        dataSet_.assign( index, message );
+      }
+
+      template < class MessageBuffer, class Entity, std::enable_if_t< Entity::codimension != 0, int > = 0 >
+      void scatter ( MessageBuffer &buff, const Entity &e, std::size_t n )
+      {}
+
+    private:
+      SparseReconstructionSet &dataSet_;
+    };
 
   } // namespace VoF
 
@@ -1,6 +1,12 @@
 #ifndef DUNE_VOF_HEIGHTFUNCTIONSTENCILS_HH
 #define DUNE_VOF_HEIGHTFUNCTIONSTENCILS_HH
 
+#include <cassert>
+#include <cstddef>
+
+#include <array>
+#include <tuple>
+
 #include <dune/common/power.hh>
 #include <dune/grid/spgrid/entity.hh>
 
@@ -15,6 +21,12 @@ namespace Dune
      /**
      * \ingroup Method
      * \brief  a single stencil for the height function method
+     * \details Construction is cheap: validity of a cell is checked against the partition when
+     *          asked for, cells beyond tup are invalid. Within the partition of the center, SPGrid
+     *          numbers cells lexicographically, so index() obtains the index of a stencil cell from
+     *          the index of the center and one stride per direction. The strides are probed on the
+     *          first call to index() only, so a stencil whose columns are all cached never builds
+     *          an entity.
      *
      * \tparam  GV  grid view
      */
@@ -31,12 +43,17 @@ namespace Dune
 
       using Orientation = std::tuple< int, int >;
 
+      using Index = typename GridView::IndexSet::IndexType;
+
       static constexpr int noc = StaticPower< 3, dim-1 >::power;
+      static constexpr int maxTup = 3;
 
     public:
       explicit HeightFunctionStencil ( const GridView &gridView, const EntityInfo &entityInfo, const Orientation &orientation, const double tup = 3 )
        : gridView_( gridView ), tup_( tup ), entityInfo_( entityInfo ), orientation_( orientation )
-      {}
+      {
+        assert( tup_ <= static_cast< std::size_t >( maxTup ) );
+      }
 
       std::size_t columns() const { return noc; }
 
@@ -44,6 +61,8 @@ namespace Dune
 
       int tup() const { return tup_; }
 
+      const Orientation &orientation() const { return orientation_; }
+
       int effectiveTdown() const
       {
         for ( int i = -1; i >= tdown(); --i )
@@ -54,15 +73,38 @@ namespace Dune
 
       Entity operator() ( const std::size_t c, const int t ) const
       {
-        EntityInfo entityInfo( entityInfo_ );
-        entityInfo.id() = getMultiIndex< dim >( c, t );
-        entityInfo.update();
-        return EntityImpl( entityInfo );
+        return entity( getMultiIndex< dim >( c, t ) );
+      }
+
+      /**
+       * \brief index of cell t in column c in the index set of the grid view
+       */
+      Index index ( const std::size_t c, const int t ) const
+      {
+        assert( valid( c, t ) );
+        probeStrides();
+        const MultiIndex m = getMultiIndex< dim >( c, t );
+        long offset = 0;
+        for( int k = 0; k < dim; ++k )
+          offset += ( ( m[ k ] - entityInfo_.id()[ k ] ) / 2 ) * strides_[ k ];
+        const Index index = static_cast< Index >( static_cast< long >( center_ ) + offset );
+        assert( index == gridView_.indexSet().index( (*this)( c, t ) ) );
+        return index;
+      }
+
+      /**
+       * \brief difference of the indices of cells t+1 and t of a column
+       */
+      long step () const
+      {
+        probeStrides();
+        return std::get< 1 >( orientation_ ) * strides_[ std::get< 0 >( orientation_ ) ];
       }
 
       bool valid ( const std::size_t c, const int t ) const
       {
-        return entityInfo_.gridLevel().template partition< All_Partition >().contains( getMultiIndex< dim >( c, t ), entityInfo_.partitionNumber() );
+        assert( ( t >= -maxTup ) && ( t <= maxTup ) );
+        return ( t >= tdown() ) && ( t <= tup() ) && contains( getMultiIndex< dim >( c, t ) );
       }
 
       template < int dimension >
@@ -100,10 +142,47 @@ namespace Dune
       }
 
     private:
+      void probeStrides () const
+      {
+        if( probed_ )
+          return;
+
+        center_ = gridView_.indexSet().index( entity( entityInfo_.id() ) );
+        for( int k = 0; k < dim; ++k )
+        {
+          MultiIndex m = entityInfo_.id();
+          m[ k ] += 2;
+          int sign = 1;
+          if( !contains( m ) )
+          {
+            m[ k ] -= 4;
+            sign = -1;
+          }
+          strides_[ k ] = contains( m ) ? sign * ( static_cast< long >( gridView_.indexSet().index( entity( m ) ) ) - static_cast< long >( center_ ) ) : 0;
+        }
+        probed_ = true;
+      }
+
+      Entity entity ( const MultiIndex &id ) const
+      {
+        EntityInfo entityInfo( entityInfo_ );
+        entityInfo.id() = id;
+        entityInfo.update();
+        return EntityImpl( entityInfo );
+      }
+
+      bool contains ( const MultiIndex &id ) const
+      {
+        return entityInfo_.gridLevel().template partition< All_Partition >().contains( id, entityInfo_.partitionNumber() );
+      }
+
       const GridView &gridView_;
       std::size_t tup_;
       const EntityInfo entityInfo_;
       const Orientation orientation_;
+      mutable bool probed_ = false;
+      mutable Index center_;
+      mutable std::array< long, dim > strides_;
     };
 
 
@@ -56,6 +56,8 @@ struct RotatingCircle < ctype, 2 >
     return 1.0 / radius( 0.0 );
   }
 
+  static double maxVelocity() { return 2 * M_PI / 10 * sqrt( 2.0 ); };
+
 private:
   DomainType rotationCenter () const
   {
@@ -101,6 +103,8 @@ struct RotatingCircle < ctype, 3 >
     rot *= 2 * M_PI / 10;
   }
 
+  static double maxVelocity() { return 2 * M_PI / 10 * sqrt( 2.0 ); };
+
 };
 
 #endif //#ifndef ROTATINGCIRCLE_HH
@@ -1,5 +1,6 @@
 #include <config.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include <iostream>
@@ -20,9 +21,11 @@
 
 #include <dune/vof/colorfunction.hh>
 #include <dune/vof/interfacegrid/grid.hh>
+#include <dune/vof/interfacegrid/surfacequadrature.hh>
 #include <dune/vof/reconstruction.hh>
 #include <dune/vof/reconstructionset.hh>
 #include <dune/vof/stencil/vertexneighborsstencil.hh>
+#include <dune/vof/utility.hh>
 
 #include "average.hh"
 #include "problems/ellipse.hh"
@@ -110,6 +113,143 @@ try
   interfaceVtkWriter.addCellData( normals, "normals", 3 );
   interfaceVtkWriter.write( "test-interfacegrid-reconstruction" );
 
+  // incremental update must reproduce a newly constructed interface grid
+#if GRIDDIM == 2
+  Ellipse< double, GridView::dimensionworld > updatedProblem( { axis, Dune::VoF::generalizedCrossProduct( axis ) }, { 0.25, 0.5 } );
+#elif GRIDDIM == 3
+  Ellipse< double, GridView::dimensionworld > updatedProblem( { axis1, axis2, axis3 }, { 0.25, 0.2, 0.4 } );
+#endif
+  Dune::VoF::Average< Ellipse< double, GridView::dimensionworld > > updatedAverage ( updatedProblem );
+  updatedAverage( colorFunction );
+
+  // attach the host element index to each interface element and its vertices
+  const auto hostIndex = [ &gridView ] ( const auto &entity ) { return static_cast< int >( gridView.indexSet().index( entity.impl().hostElement() ) ); };
+  Dune::PersistentContainer< InterfaceGrid, int > hostIndices( interfaceGrid, 0, -1 );
+  Dune::PersistentContainer< InterfaceGrid, int > vertexIndices( interfaceGrid, InterfaceGrid::dimension, -1 );
+  for( const auto &entity : elements( interfaceGrid.leafGridView() ) )
+  {
+    hostIndices[ entity ] = hostIndex( entity );
+    for( unsigned int j = 0; j < entity.subEntities( InterfaceGrid::dimension ); ++j )
+      vertexIndices( entity, j ) = 16 * hostIndex( entity ) + j;
+  }
+
+  interfaceGrid.update( colorFunction );
+
+  hostIndices.resize( -1 );
+  vertexIndices.resize( -1 );
+  std::size_t carriedElements = 0, carriedVertices = 0;
+  for( const auto &entity : elements( interfaceGrid.leafGridView() ) )
+  {
+    if( hostIndices[ entity ] != -1 )
+    {
+      if( hostIndices[ entity ] != hostIndex( entity ) )
+        DUNE_THROW( Dune::GridError, "PersistentContainer lost track of an interface element" );
+      ++carriedElements;
+    }
+
+    for( unsigned int j = 0; j < entity.subEntities( InterfaceGrid::dimension ); ++j )
+    {
+      if( vertexIndices( entity, j ) == -1 )
+        continue;
+      if( vertexIndices( entity, j ) != static_cast< int >( 16 * hostIndex( entity ) + j ) )
+        DUNE_THROW( Dune::GridError, "PersistentContainer lost track of an interface vertex" );
+      ++carriedVertices;
+    }
+  }
+  if( (carriedElements == 0) || (carriedVertices == 0) )
+    DUNE_THROW( Dune::GridError, "PersistentContainer did not carry any data through the update" );
+
+  auto newInterfaceGrid = Dune::VoF::interfaceGrid( colorFunction, Dune::VoF::reconstruction( stencils ) );
+
+  if( interfaceGrid.leafGridView().size( 0 ) != newInterfaceGrid.leafGridView().size( 0 ) )
+    DUNE_THROW( Dune::GridError, "Updated interface grid has a different number of elements" );
+  if( interfaceGrid.numBoundarySegments() != newInterfaceGrid.numBoundarySegments() )
+    DUNE_THROW( Dune::GridError, "Updated interface grid has a different number of vertices" );
+
+  auto newEntity = newInterfaceGrid.leafGridView().begin< 0 >();
+  for( const auto &entity : elements( interfaceGrid.leafGridView() ) )
+  {
+    const auto geometry = entity.geometry();
+    const auto newGeometry = (*newEntity++).geometry();
+    if( geometry.corners() != newGeometry.corners() )
+      DUNE_THROW( Dune::GridError, "Updated interface grid has a different geometry" );
+    for( int i = 0; i < geometry.corners(); ++i )
+      if( (geometry.corner( i ) - newGeometry.corner( i )).two_norm() > 1e-12 )
+        DUNE_THROW( Dune::GridError, "Updated interface grid has a different geometry" );
+  }
+  checkIterators( interfaceGrid.leafGridView() );
+
+  // adopting flags and reconstructions must give the same interface
+  InterfaceGrid adoptedGrid( newInterfaceGrid.flags(), newInterfaceGrid.dataSet().reconstructionSet() );
+  if( adoptedGrid.numBoundarySegments() != newInterfaceGrid.numBoundarySegments() )
+    DUNE_THROW( Dune::GridError, "Interface grid on adopted reconstructions differs" );
+  checkIterators( adoptedGrid.leafGridView() );
+
+  // surface quadrature must reproduce the interface area
+  Dune::VoF::SurfaceQuadrature< InterfaceGrid > quadrature( interfaceGrid, 2 );
+  double area = 0.0, moment = 0.0;
+  for( const auto &entity : elements( interfaceGrid.leafGridView(), Dune::Partitions::interior ) )
+  {
+    const auto geometry = entity.geometry();
+    const auto &normal = interfaceGrid.dataSet().reconstructionSet()[ entity.impl().hostElement() ].innerNormal();
+    area += geometry.volume();
+    moment += (geometry.center() * normal) * geometry.volume();
+  }
+  const double integral = quadrature.integrate( [] ( const auto &x, const auto &normal, std::size_t i ) { return 1.0; } );
+  if( std::abs( area - integral ) > 1e-12 )
+    DUNE_THROW( Dune::GridError, "Surface quadrature does not integrate constants exactly" );
+  const double linearIntegral = quadrature.integrate( [] ( const auto &x, const auto &normal, std::size_t i ) { return x * normal; } );
+  if( std::abs( moment - linearIntegral ) > 1e-12 )
+    DUNE_THROW( Dune::GridError, "Surface quadrature does not integrate linear functions exactly" );
+
+  // connected interface mesh must share vertices between neighboring elements
+  const double meshTolerance = 0.5;
+  const auto &meshReconstructions = newInterfaceGrid.dataSet().reconstructionSet();
+  std::vector< Coordinate > meshVertices;
+  std::vector< std::size_t > meshOffsets, meshIndices;
+  Dune::VoF::getInterfaceMesh( meshReconstructions, newInterfaceGrid.flags(), meshVertices, meshOffsets, meshIndices, meshTolerance );
+  if( meshIndices.size() != newInterfaceGrid.numBoundarySegments() )
+    DUNE_THROW( Dune::GridError, "Interface mesh has a different number of element vertices" );
+  if( !meshIndices.empty() && meshVertices.size() >= meshIndices.size() )
+    DUNE_THROW( Dune::GridError, "Interface mesh does not share vertices" );
+
+  // each vertex must lie on the reconstruction and in the closure of every host cell using it
+  std::size_t meshElement = 0;
+  for( const auto &entity : elements( gridView ) )
+  {
+    if( !newInterfaceGrid.flags().isMixed( entity ) )
+      continue;
+
+    const auto geometry = entity.geometry();
+    const double h = std::pow( geometry.volume(), 1.0 / GridView::dimension );
+    Coordinate lower = geometry.corner( 0 ), upper = geometry.corner( 0 );
+    for( int i = 1; i < geometry.corners(); ++i )
+      for( int k = 0; k < GridView::dimensionworld; ++k )
+      {
+        lower[ k ] = std::min( lower[ k ], geometry.corner( i )[ k ] );
+        upper[ k ] = std::max( upper[ k ], geometry.corner( i )[ k ] );
+      }
+
+    const std::size_t begin = meshOffsets[ meshElement ], end = meshOffsets[ meshElement+1 ];
+    for( std::size_t j = begin; j < end; ++j )
+    {
+      if( meshIndices[ j ] >= meshVertices.size() )
+        DUNE_THROW( Dune::GridError, "Interface mesh refers to a nonexistent vertex" );
+      if( std::find( meshIndices.begin() + begin, meshIndices.begin() + j, meshIndices[ j ] ) != meshIndices.begin() + j )
+        DUNE_THROW( Dune::GridError, "Interface mesh element uses a vertex twice" );
+
+      const Coordinate &x = meshVertices[ meshIndices[ j ] ];
+      if( std::abs( meshReconstructions[ entity ].levelSet( x ) ) > meshTolerance * h + 1e-12 )
+        DUNE_THROW( Dune::GridError, "Interface mesh vertex is too far from the reconstruction" );
+      for( int k = 0; k < GridView::dimensionworld; ++k )
+        if( (x[ k ] < lower[ k ] - 1e-12) || (x[ k ] > upper[ k ] + 1e-12) )
+          DUNE_THROW( Dune::GridError, "Interface mesh connects elements of cells that do not touch" );
+    }
+    ++meshElement;
+  }
+  if( meshOffsets.size() != meshElement + 1 )
+    DUNE_THROW( Dune::GridError, "Interface mesh has a different number of elements" );
+
   return 0;
 }
 catch( const Dune::Exception &e )
@@ -0,0 +1,165 @@
+#ifndef DUNE_VOF_TIMESTEPCONTROL_HH
+#define DUNE_VOF_TIMESTEPCONTROL_HH
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/partitionset.hh>
+
+#include <dune/vof/common/mpitraits.hh>
+
+namespace Dune
+{
+  namespace VoF
+  {
+
+    // TimeStepControl
+    // ---------------
+
+    /**
+     * \ingroup Method
+     * \brief reduction of local time step estimates to a global time step
+     * \details Three modes are available:
+     *          - global: blocking minimum over all ranks in every step (default),
+     *          - fixed:  a constant estimate given on construction, no communication at all,
+     *          - lagged: non-blocking minimum, the result is applied one step later.
+     *          In lagged mode the first call blocks, every later call returns the reduction
+     *          started in the call before.
+     *
+     * \tparam  Comm  collective communication type
+     */
+    template< class Comm >
+    class TimeStepControl
+    {
+      using This = TimeStepControl< Comm >;
+
+    public:
+      using CollectiveCommunication = Comm;
+
+      enum class Mode { global, fixed, lagged };
+
+      explicit TimeStepControl ( const CollectiveCommunication &comm, Mode mode = Mode::global, double fixedEstimate = std::numeric_limits< double >::max() )
+        : comm_( comm ), mode_( mode ), fixedEstimate_( fixedEstimate )
+      {}
+
+      TimeStepControl ( const This &other )
+        : comm_( other.comm_ ), mode_( other.mode_ ), fixedEstimate_( other.fixedEstimate_ )
+      {}
+
+      ~TimeStepControl () { finish(); }
+
+      static Mode parseMode ( const std::string &name )
+      {
+        if( name == "global" )
+          return Mode::global;
+        else if( name == "fixed" )
+          return Mode::fixed;
+        else if( name == "lagged" )
+          return Mode::lagged;
+        DUNE_THROW( InvalidStateException, "Unknown time step control: " << name );
+      }
+
+      /**
+       * \brief return global time step estimate
+       *
+       * \param   dtEst   local time step estimate of this rank
+       */
+      double operator() ( double dtEst )
+      {
+        switch( mode_ )
+        {
+        case Mode::fixed:
+          return fixedEstimate_;
+
+        case Mode::lagged:
+          return lagged( dtEst, IsMPICommunication< CollectiveCommunication >() );
+
+        default:
+          return comm_.min( dtEst );
+        }
+      }
+
+      Mode mode () const { return mode_; }
+
+    private:
+      double lagged ( double dtEst, std::false_type ) { return comm_.min( dtEst ); }
+
+#if HAVE_MPI
+      double lagged ( double dtEst, std::true_type )
+      {
+        if( !pending_ )
+        {
+          local_ = dtEst;
+          global_ = comm_.min( dtEst );
+        }
+        else
+          MPI_Wait( &request_, MPI_STATUS_IGNORE );
+
+        const double result = global_;
+
+        local_ = dtEst;
+        MPI_Iallreduce( &local_, &global_, 1, MPI_DOUBLE, MPI_MIN, static_cast< MPI_Comm >( comm_ ), &request_ );
+        pending_ = true;
+
+        return result;
+      }
+
+      void finish ()
+      {
+        if( pending_ )
+          MPI_Wait( &request_, MPI_STATUS_IGNORE );
+        pending_ = false;
+      }
+
+      MPI_Request request_;
+      bool pending_ = false;
+#else // #if HAVE_MPI
+      void finish () {}
+#endif // #else // #if HAVE_MPI
+
+      CollectiveCommunication comm_;
+      Mode mode_;
+      double fixedEstimate_;
+      double local_ = 0.0, global_ = 0.0;
+    };
+
+
+
+    // velocityBoundEstimate
+    // ---------------------
+
+    /**
+     * \ingroup Method
+     * \brief time step estimate from a global bound of the velocity
+     * \details Bounds the estimate of the evolution operator, volume / sum( |face| |v * n| ),
+     *          from below by replacing |v * n| with the velocity bound. Requires one reduction.
+     *
+     * \param   gridView      grid view
+     * \param   maxVelocity   bound of the velocity magnitude in the whole domain
+     */
+    template< class GridView >
+    double velocityBoundEstimate ( const GridView &gridView, double maxVelocity )
+    {
+      double dtEst = std::numeric_limits< double >::max();
+
+      for( const auto &entity : elements( gridView, Partitions::interiorBorder ) )
+      {
+        double sumFaces = 0.0;
+        for( const auto &intersection : intersections( gridView, entity ) )
+          sumFaces += intersection.geometry().volume();
+
+        dtEst = std::min( dtEst, entity.geometry().volume() / ( sumFaces * maxVelocity ) );
+      }
+
+      return gridView.comm().min( dtEst );
+    }
+
+  } // namespace VoF
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_VOF_TIMESTEPCONTROL_HH
@@ -1,9 +1,21 @@
 #ifndef DUNE_VOF_UTILITY_HH
 #define DUNE_VOF_UTILITY_HH
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
 // dune-common includes
 #include <dune/common/fmatrix.hh>
 
+// dune-geometry includes
+#include <dune/geometry/referenceelements.hh>
+
 // dune-vof includes
 #include <dune/vof/geometry/2d/polygon.hh>
 #include <dune/vof/geometry/polytope.hh>
@@ -14,6 +26,13 @@ namespace Dune
   namespace VoF
   {
 
+    template< class T, class ctype >
+    ctype clamp( T v, ctype lo, ctype hi )
+    {
+      return std::max( std::min( static_cast< ctype >( v ), hi ), lo );
+    }
+
+
     // Generate input for interface grid
     // ---------------------------------
     template< class ReconstructionSet, class Flags >
@@ -48,12 +67,108 @@ namespace Dune
     }
 
 
-    template< class ctype >
-    ctype clamp( ctype v, ctype lo, ctype hi )
+    // Generate connected interface mesh
+    // ---------------------------------
+
+    /**
+     * \brief extract the interface as an indexed mesh with shared vertices
+     * \details Every vertex of an interface element lies on an edge of its host cell (or on one
+     *          of the edge's end points). Vertices on the same edge (or grid vertex) of
+     *          neighboring cells are shared if their positions differ by less than tolerance
+     *          times the size of the cell. A shared vertex keeps the position computed first, so
+     *          it lies within that distance of the reconstruction of each element using it. Where
+     *          the reconstructions of neighboring cells do not meet, the mesh stays open. Offsets
+     *          are given per mixed cell into indices, which refer to vertices.
+     */
+    template< class ReconstructionSet, class Flags >
+    void getInterfaceMesh(
+      const ReconstructionSet &reconstructions,
+      const Flags &flags,
+      std::vector< typename ReconstructionSet::DataType::Coordinate > &vertices,
+      std::vector< std::size_t > &offsets,
+      std::vector< std::size_t > &indices,
+      typename ReconstructionSet::GridView::ctype tolerance = 1e-8
+    )
     {
-      return std::max( std::min( v, hi ), lo );
-    }
+      using GridView = typename ReconstructionSet::GridView;
+      using Coordinate = typename ReconstructionSet::DataType::Coordinate;
+      using ctype = typename GridView::ctype;
+
+      static const int dim = GridView::dimension;
+
+      const GridView &gridView = reconstructions.gridView();
+      const auto &indexSet = gridView.indexSet();
+
+      vertices.clear();
+      offsets.clear();
+      indices.clear();
+      offsets.push_back( 0 );
 
+      // vertices on each edge or grid vertex; both may share an index, the lowest bit tells them apart
+      std::unordered_map< std::size_t, std::vector< std::size_t > > unique;
+
+      for( const auto &entity : elements( gridView ) )
+      {
+        if ( !flags.isMixed( entity ) )
+          continue;
+
+        auto polytope = interface( entity, reconstructions );
+        assert( polytope.size() > 0 );
+
+        const auto geometry = entity.geometry();
+        const auto &refElement = ReferenceElements< ctype, dim >::general( entity.type() );
+        const ctype h = std::pow( geometry.volume(), 1.0 / dim );
+        const ctype cornerTolerance = std::numeric_limits< ctype >::epsilon() * 1e3 * h;
+
+        for ( std::size_t i = 0; i < polytope.size(); ++i )
+        {
+          const Coordinate x = polytope.vertex( i );
+
+          // find edge of the host cell closest to the vertex
+          std::size_t key = 0;
+          ctype minDistance = std::numeric_limits< ctype >::max();
+          for ( int e = 0; e < refElement.size( dim-1 ); ++e )
+          {
+            const int ia = refElement.subEntity( e, dim-1, 0, dim );
+            const int ib = refElement.subEntity( e, dim-1, 1, dim );
+            const Coordinate a = geometry.corner( ia );
+            const Coordinate b = geometry.corner( ib );
+
+            const Coordinate ab = b - a;
+            const ctype t = clamp( ( x - a ) * ab / ab.two_norm2(), ctype( 0 ), ctype( 1 ) );
+            Coordinate y = a;
+            y.axpy( t, ab );
+
+            const ctype distance = ( x - y ).two_norm();
+            if ( distance >= minDistance )
+              continue;
+
+            minDistance = distance;
+            if ( ( x - a ).two_norm() < cornerTolerance )
+              key = 2 * indexSet.subIndex( entity, ia, dim ) + 1;
+            else if ( ( x - b ).two_norm() < cornerTolerance )
+              key = 2 * indexSet.subIndex( entity, ib, dim ) + 1;
+            else
+              key = 2 * indexSet.subIndex( entity, e, dim-1 );
+          }
+
+          std::vector< std::size_t > &candidates = unique[ key ];
+          const auto pos = std::find_if( candidates.begin(), candidates.end(), [ &vertices, &x, h, tolerance ] ( std::size_t j ) {
+              return ( vertices[ j ] - x ).two_norm() < tolerance * h;
+            } );
+          if ( pos != candidates.end() )
+            indices.push_back( *pos );
+          else
+          {
+            candidates.push_back( vertices.size() );
+            indices.push_back( vertices.size() );
+            vertices.push_back( x );
+          }
+        }
+
+        offsets.push_back( indices.size() );
+      }
+    }
 
   } // namespace VoF
 
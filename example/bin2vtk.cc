@@ -3,12 +3,18 @@
 #endif
 
 // C++ includes
+#include <algorithm>
+#include <exception>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 // dune-common includes
 #include <dune/common/exceptions.hh>
@@ -31,6 +37,10 @@
 #include <dune/vof/flagging.hh>
 #include <dune/vof/flagset.hh>
 #include <dune/vof/interfacegrid/grid.hh>
+#include <dune/vof/io/interfacesnapshot.hh>
+#include <dune/vof/io/mappedcolorfunction.hh>
+#include <dune/vof/io/sharedsnapshot.hh>
+#include <dune/vof/io/vtkwriter.hh>
 #include <dune/vof/reconstruction.hh>
 #include <dune/vof/stencil/vertexneighborsstencil.hh>
 #include <dune/vof/stencil/edgeneighborsstencil.hh>
@@ -41,11 +51,9 @@
 struct DataOutputParameters
 : public Dune::Fem::LocalParameter< Dune::Fem::DataOutputParameters, DataOutputParameters >
 {
-  DataOutputParameters ( const int level, const int savecount )
-   : level_ ( level ), savecount_ ( savecount )
-  {
-    Dune::ParameterTreeParser::readINITree( "parameter", parameters_ );
-  }
+  DataOutputParameters ( const Dune::ParameterTree &parameters, const int level, const int savecount )
+   : level_ ( level ), savecount_ ( savecount ), parameters_ ( parameters )
+  {}
 
   virtual bool willWrite ( bool write ) const { return true; }
 
@@ -66,7 +74,7 @@ struct DataOutputParameters
 
 private:
   int level_, savecount_;
-  Dune::ParameterTree parameters_;
+  const Dune::ParameterTree &parameters_;
 };
 
 
@@ -76,11 +84,9 @@ private:
 struct RecOutputParameters
 : public Dune::Fem::LocalParameter< Dune::Fem::DataOutputParameters, RecOutputParameters >
 {
-  RecOutputParameters ( const int level, const int savecount )
-   : level_ ( level ), savecount_ ( savecount )
-   {
-     Dune::ParameterTreeParser::readINITree( "parameter", parameters_ );
-   }
+  RecOutputParameters ( const Dune::ParameterTree &parameters, const int level, const int savecount )
+   : level_ ( level ), savecount_ ( savecount ), parameters_ ( parameters )
+  {}
 
   virtual bool willWrite ( bool write ) const { return true; }
 
@@ -101,7 +107,7 @@ struct RecOutputParameters
 
 private:
   int level_, savecount_;
-  Dune::ParameterTree parameters_;
+  const Dune::ParameterTree &parameters_;
 
 };
 
@@ -138,11 +144,219 @@ private:
 
 
 
+// MultipleMPI
+// -----------
+
+// Initializes MPI such that several threads may communicate concurrently, if supported.
+struct MultipleMPI
+{
+  MultipleMPI ( int &argc, char **&argv )
+  {
+#if HAVE_MPI
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided_ );
+#endif
+  }
+
+  ~MultipleMPI ()
+  {
+#if HAVE_MPI
+    MPI_Finalize();
+#endif
+  }
+
+  bool supported () const
+  {
+#if HAVE_MPI
+    return ( provided_ >= MPI_THREAD_MULTIPLE );
+#else
+    return true;
+#endif
+  }
+
+private:
+  int provided_ = 0;
+};
+
+
+
+// Converter
+// ---------
+
+// Operators and data to convert one snapshot at a time. Each worker thread owns a converter,
+// only the (read-only) stencils are shared.
+template< class GridView >
+struct Converter
+{
+  using ColorFunction = Dune::VoF::ColorFunction< GridView >;
+  using Stencils = Dune::VoF::VertexNeighborsStencil< GridView >;
+  using ReconstructionSet = Dune::VoF::ReconstructionSet< GridView >;
+  using Reconstruction = decltype( Dune::VoF::reconstruction( std::declval< Stencils & >() ) );
+  using FlagSet = Dune::VoF::FlagSet< GridView >;
+  using CurvatureOperator = Dune::VoF::CartesianHeightFunctionCurvature< GridView, Stencils >;
+  using CurvatureSet = Dune::VoF::CurvatureSet< GridView >;
+  using InterfaceGrid = Dune::VoF::InterfaceGrid< Reconstruction >;
+
+  Converter ( const GridView &gridView, Stencils &stencils, const Dune::ParameterTree &parameters, const std::string &path, double eps, bool shared, bool mapped, bool appended, bool compress )
+    : gridView_( gridView ), parameters_( parameters ), path_( path ), shared_( shared ), mapped_( mapped ), appended_( appended ), compress_( compress ),
+      uh_( gridView ), dfFlags_( gridView ),
+      reconstruction_( Dune::VoF::reconstruction( stencils ) ), reconstructions_( gridView ),
+      flagOperator_( eps ), flags_( gridView ),
+      curvatureOperator_( stencils, reconstruction_.columns() ), curvatureSet_( gridView )
+  {}
+
+  // base name of a snapshot file
+  static std::string filename ( const GridView &gridView, const Dune::ParameterTree &parameters, const std::string &path, bool shared, int level, std::size_t number )
+  {
+    DataOutputParameters dataOutputParameters ( parameters, level, number );
+
+    std::stringstream filename;
+    filename.fill('0');
+    if ( shared )
+      filename  << "./" << path << "/" << dataOutputParameters.prefix() << std::setw(5) << number;
+    else
+      filename  << "./" << path << "/"  << "s" << std::setw(4) << gridView.comm().size() << "-p" << std::setw(4) << gridView.comm().rank()
+        << "-" << dataOutputParameters.prefix() << std::setw(5) << number;
+    return filename.str();
+  }
+
+  // convert a snapshot and return its time
+  double operator() ( int level, std::size_t number )
+  {
+    // Open binary file
+    // ----------------
+    const std::string name = filename( gridView_, parameters_, path_, shared_, level, number ) + ".bin";
+
+    if ( shared_ )
+    {
+      Dune::VoF::SharedSnapshot< GridView > snapshot( gridView_ );
+      const double timeValue = snapshot.read( name, uh_ );
+      return convert( uh_, timeValue, false, level, number );
+    }
+
+    using BinaryStream = Dune::Fem::BinaryFileInStream;
+    bool hasInterface = false;
+
+    if ( mapped_ )
+    {
+      // map the color function, only header and interface block are read
+      BinaryStream binaryStream ( name );
+      Dune::VoF::MappedColorFunction< GridView > uh( gridView_, name, binaryStream );
+
+      binaryStream.readBool( hasInterface );
+      if ( hasInterface )
+        interfaceSnapshot_.read( binaryStream );
+
+      return convert( uh, uh.time(), hasInterface, level, number );
+    }
+
+    BinaryStream binaryStream ( name );
+
+    double timeValue;
+    binaryStream >> timeValue;
+
+    uh_.read( binaryStream );
+    uh_.communicate();
+
+    binaryStream.readBool( hasInterface );
+    if ( hasInterface )
+      interfaceSnapshot_.read( binaryStream );
+
+    return convert( uh_, timeValue, hasInterface, level, number );
+  }
+
+private:
+  template< class Color >
+  double convert ( const Color &uh, double timeValue, bool hasInterface, int level, std::size_t number )
+  {
+    DataOutputParameters dataOutputParameters ( parameters_, level, number );
+    RecOutputParameters recOutputParameters ( parameters_, level, number );
+
+    // Load or rebuild flags and reconstruction
+    // ----------------------------------------
+    if ( hasInterface )
+      interfaceSnapshot_.scatter( gridView_, flags_, reconstructions_, curvatureSet_ );
+    else
+    {
+      flagOperator_( uh, flags_ );
+      reconstruction_( uh, reconstructions_, flags_ );
+      curvatureOperator_( uh, reconstructions_, flags_, curvatureSet_ );
+    }
+
+    // Write data
+    // ----------
+    for ( const auto &entity : elements( gridView_ ) )
+      dfFlags_[ entity ] = static_cast< double > ( flags_[ entity ] );
+
+    std::stringstream vtkfile;
+    vtkfile.fill('0');
+    vtkfile << dataOutputParameters.prefix() << std::setw(5) << number;
+
+    std::stringstream recfile;
+    recfile.fill('0');
+    recfile << recOutputParameters.prefix() << std::setw(5) << number;
+
+    if ( appended_ )
+    {
+      Dune::VoF::VTUWriter< GridView > vtuWriter( gridView_, compress_ );
+      vtuWriter.addCellData( uh, "celldata" );
+      vtuWriter.addCellData( flags_, "flags" );
+      vtuWriter.write( dataOutputParameters.path(), vtkfile.str() );
+
+      Dune::VoF::InterfaceVTPWriter< GridView > vtpWriter( gridView_, compress_ );
+      vtpWriter.addCellData( curvatureSet_, "curvature" );
+      vtpWriter.write( recOutputParameters.path(), recfile.str(), reconstructions_, flags_ );
+      return timeValue;
+    }
+
+    Dune::VTKWriter< GridView > vtkwriter ( gridView_ );
+    vtkwriter.addCellData ( uh, "celldata" );
+    vtkwriter.addCellData ( dfFlags_, "flags" );
+    vtkwriter.pwrite( vtkfile.str(), dataOutputParameters.path(), "" );
+
+    // Write reconstruction
+    // --------------------
+    // the grid adopts flags and reconstructions of this converter and is updated incrementally,
+    // since consecutive snapshots share most of the interface
+    if ( interfaceGrid_ )
+      interfaceGrid_->update( flags_, reconstructions_ );
+    else
+      interfaceGrid_.reset( new InterfaceGrid( flags_, reconstructions_ ) );
+
+    Dune::VoF::DataSet< typename InterfaceGrid::LeafGridView, double > curvatureOnInterface ( interfaceGrid_->leafGridView() );
+    for ( const auto entity : elements( interfaceGrid_->leafGridView() ) )
+      curvatureOnInterface[ entity ] = curvatureSet_[ entity.impl().hostElement() ];
+
+    Dune::VTKWriter< typename InterfaceGrid::LeafGridView > interfaceVtkWriter( interfaceGrid_->leafGridView() );
+    interfaceVtkWriter.addCellData( curvatureOnInterface, "curvature" );
+    interfaceVtkWriter.pwrite( recfile.str(), recOutputParameters.path(), "" );
+
+    return timeValue;
+  }
+
+  GridView gridView_;
+  const Dune::ParameterTree &parameters_;
+  std::string path_;
+  bool shared_, mapped_, appended_, compress_;
+
+  ColorFunction uh_, dfFlags_;
+  Reconstruction reconstruction_;
+  ReconstructionSet reconstructions_;
+  Dune::VoF::FlagOperator< GridView > flagOperator_;
+  FlagSet flags_;
+  CurvatureOperator curvatureOperator_;
+  CurvatureSet curvatureSet_;
+  Dune::VoF::InterfaceSnapshot< GridView > interfaceSnapshot_;
+  std::unique_ptr< InterfaceGrid > interfaceGrid_;
+};
+
+
+
 // Write Binary data file to VTK file
 // ----------------------------------
 
 int main( int argc, char** argv )
 try {
+  MultipleMPI multipleMPI( argc, argv );
   Dune::MPIHelper::instance( argc, argv );
 
   // read parameter file
@@ -156,6 +370,13 @@ try {
   std::size_t level ( parameters.get< std::size_t >( "grid.level", 0 ) );
   std::size_t repeats ( parameters.get< std::size_t >( "grid.repeats", 0 ) );
   const std::string path = parameters.get< std::string >( "io.path", "data" );
+  const bool shared = ( parameters.get< std::string >( "io.format", "rank" ) == "shared" );
+  const bool mapped = parameters.get< bool >( "io.mmap", false );
+  const bool appended = ( parameters.get< std::string >( "io.vtkformat", "dune" ) == "appended" );
+  const bool compress = parameters.get< bool >( "io.vtkcompress", false );
+  std::size_t threads = parameters.get< std::size_t >( "io.convertthreads", 0 );
+  if ( threads == 0 )
+    threads = std::max( std::thread::hardware_concurrency(), 1u );
 
   if ( argc > 1 )
   {
@@ -180,107 +401,72 @@ try {
     const int refineStepsForHalf = Dune::DGFGridInfo< GridType >::refineStepsForHalf();
     grid.globalRefine( level * refineStepsForHalf );
 
-
-    std::stringstream seriesName;
-    seriesName.fill('0');
-    seriesName << "./" << path << "/" << "s" << std::setw(4) << grid.comm().size() << "-vof-" << level;
-
-    PVDWriter dataPVDWriter ( seriesName.str() + "-data.pvd", "pvtu" );
-    PVDWriter recPVDWriter ( seriesName.str() + "-reconstruction.pvd", GridType::dimension == 2 ? "pvtp" : "pvtu" );
-
-    // Create discrete function
-    // ------------------------
     using GridView = typename GridType::LeafGridView;
-    using ColorFunction = Dune::VoF::ColorFunction< GridView >;
-
     GridView gridView( grid.leafGridView() );
-    ColorFunction uh( gridView );
-
-    using Stencils = Dune::VoF::VertexNeighborsStencil< GridView >;
-    Stencils stencils( gridView );
-
-    using ReconstructionSet = Dune::VoF::ReconstructionSet< GridView >;
-    ReconstructionSet reconstructions( gridView );
-    auto reconstruction = Dune::VoF::reconstruction( stencils );
 
+    using ConverterType = Converter< GridView >;
+    typename ConverterType::Stencils stencils( gridView );
+
+    // Discover snapshots
+    // ------------------
+    std::size_t count = 0;
+    while ( std::ifstream ( ConverterType::filename( gridView, parameters, path, shared, level, count ) + ".bin" ) )
+      ++count;
+    count = grid.comm().min( count );
+
+    // Convert snapshots
+    // -----------------
+    // Snapshots are converted concurrently on a single rank only: on several ranks, concurrent
+    // conversions would interleave their messages.
+    const std::size_t workers = ( grid.comm().size() == 1 && multipleMPI.supported() ? std::min( threads, std::max( count, std::size_t( 1 ) ) ) : 1 );
     const double eps = parameters.get< double >( "scheme.eps", 1e-9 );
 
-    using FlagSet = Dune::VoF::FlagSet< GridView >;
-    FlagSet flags( gridView );
-    auto flagOperator = Dune::VoF::FlagOperator< GridView >( eps );
-    ColorFunction dfFlags ( gridView );
+    std::vector< std::unique_ptr< ConverterType > > converters;
+    for ( std::size_t t = 0; t < workers; ++t )
+      converters.emplace_back( new ConverterType( gridView, stencils, parameters, path, eps, shared, mapped, appended, compress ) );
 
-    using CurvatureOperator = Dune::VoF::CartesianHeightFunctionCurvature< GridView, Stencils >;
-    CurvatureOperator curvatureOperator ( stencils );
-    using CurvatureSet = Dune::VoF::CurvatureSet< GridView >;
-    CurvatureSet curvatureSet( gridView );
-
-
-    Dune::VTKWriter< GridView > vtkwriter ( gridView );
-    vtkwriter.addCellData ( uh, "celldata" );
-    vtkwriter.addCellData ( dfFlags, "flags" );
-
-    for ( std::size_t number = 0; ; number++ )
+    std::vector< double > times( count );
+    std::vector< std::exception_ptr > exceptions( workers );
+    // each worker converts a contiguous block of snapshots, so that consecutive snapshots meet the
+    // same converter and its interface grid is updated incrementally
+    auto work = [ & ] ( std::size_t t )
     {
-      DataOutputParameters dataOutputParameters ( level, number );
-      RecOutputParameters recOutputParameters ( level, number );
-
-      // Open next binary file
-      // ---------------------
-      std::stringstream filename;
-      filename.fill('0');
-      filename  << "./" << path << "/"  << "s" << std::setw(4) << grid.comm().size() << "-p" << std::setw(4) << grid.comm().rank()
-        << "-" << dataOutputParameters.prefix() << std::setw(5) << number;
-
-      if ( !std::ifstream ( filename.str() + ".bin" ) ) break;
-
-      using BinaryStream = Dune::Fem::BinaryFileInStream;
-      BinaryStream binaryStream ( filename.str() + ".bin" );
-
-      double timeValue;
-      binaryStream >> timeValue;
-
-      uh.read( binaryStream );
-      uh.communicate();
-
-      // Rebuild flags and reconstruction
-      // --------------------------------
-      flagOperator( uh, flags );
-      reconstruction( uh, reconstructions, flags );
-      curvatureOperator( uh, reconstructions, flags, curvatureSet );
-
-      // Write data
-      // ----------
-      for ( const auto &entity : elements( gridView ) )
-        dfFlags[ entity ] = static_cast< double > ( flags[ entity ] );
-
-      std::stringstream vtkfile;
-      vtkfile.fill('0');
-      vtkfile << dataOutputParameters.prefix() << std::setw(5) << number;
-      vtkwriter.pwrite( vtkfile.str(), dataOutputParameters.path(), "" );
-      dataPVDWriter.addDataSet( grid.comm().size(), dataOutputParameters.prefix(), number, timeValue );
-
-      // Write reconstruction
-      // --------------------
-      using InterfaceGrid = Dune::VoF::InterfaceGrid< decltype( reconstruction ) >;
-      InterfaceGrid interfaceGrid( uh, stencils );
-
-      std::stringstream recfile;
-      recfile.fill('0');
-      recfile << recOutputParameters.prefix() << std::setw(5) << number;
-
-
-      Dune::VoF::DataSet< InterfaceGrid::LeafGridView, double > curvatureOnInterface ( interfaceGrid.leafGridView() );
-      for ( const auto entity : elements( interfaceGrid.leafGridView() ) )
-        curvatureOnInterface[ entity ] = curvatureSet[ entity.impl().hostElement() ];
+      try
+      {
+        const std::size_t end = count * (t+1) / workers;
+        for ( std::size_t number = count * t / workers; number < end; ++number )
+          times[ number ] = (*converters[ t ])( level, number );
+      }
+      catch ( ... )
+      {
+        exceptions[ t ] = std::current_exception();
+      }
+    };
+
+    std::vector< std::thread > pool;
+    for ( std::size_t t = 1; t < workers; ++t )
+      pool.emplace_back( work, t );
+    work( 0 );
+    for ( auto &thread : pool )
+      thread.join();
+    for ( const auto &exception : exceptions )
+      if ( exception )
+        std::rethrow_exception( exception );
+
+    // Write collections
+    // -----------------
+    std::stringstream seriesName;
+    seriesName.fill('0');
+    seriesName << "./" << path << "/" << "s" << std::setw(4) << grid.comm().size() << "-vof-" << level;
 
+    PVDWriter dataPVDWriter ( seriesName.str() + "-data.pvd", "pvtu" );
+    PVDWriter recPVDWriter ( seriesName.str() + "-reconstruction.pvd", ( appended || GridType::dimension == 2 ) ? "pvtp" : "pvtu" );
 
-      Dune::VTKWriter< InterfaceGrid::LeafGridView > interfaceVtkWriter( interfaceGrid.leafGridView() );
-      interfaceVtkWriter.addCellData( curvatureOnInterface, "curvature" );
-      interfaceVtkWriter.pwrite( recfile.str(), recOutputParameters.path(), "" );
-      recPVDWriter.addDataSet( grid.comm().size(), recOutputParameters.prefix(), number, timeValue );
+    for ( std::size_t number = 0; number < count; ++number )
+    {
+      dataPVDWriter.addDataSet( grid.comm().size(), DataOutputParameters( parameters, level, number ).prefix(), number, times[ number ] );
+      recPVDWriter.addDataSet( grid.comm().size(), RecOutputParameters( parameters, level, number ).prefix(), number, times[ number ] );
     }
-
   }
 
   return 0;
@@ -291,4 +477,3 @@ catch (Dune::Exception &e){
 catch (...){
   std::cerr << "Unknown exception thrown!" << std::endl;
 }
-
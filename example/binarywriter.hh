@@ -2,11 +2,21 @@
 #define BINARYWRITER_HH
 
 // C++ includes
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 
 // dune-common includes
+#include <dune/common/exceptions.hh>
 #include <dune/common/path.hh>
 #include <dune/common/parametertree.hh>
 
@@ -14,12 +24,93 @@
 #include <dune/fem/io/io.hh>
 #include <dune/fem/io/streams/binarystreams.hh>
 
+// dune-vof includes
+#include <dune/vof/curvature/cartesianheightfunctioncurvature.hh>
+#include <dune/vof/curvatureset.hh>
+#include <dune/vof/flagging.hh>
+#include <dune/vof/flagset.hh>
+#include <dune/vof/io/interfacesnapshot.hh>
+#include <dune/vof/io/sharedsnapshot.hh>
+#include <dune/vof/io/vtkwriter.hh>
+#include <dune/vof/reconstruction.hh>
+#include <dune/vof/reconstructionset.hh>
+#include <dune/vof/stencil/vertexneighborsstencil.hh>
+
 
 // BinaryDataWriter
 // ================
+/*
+ * With io.writequeue > 0, snapshots are copied into a buffer and written by a background thread,
+ * so the time loop continues while the previous snapshot is on its way to disk. At most
+ * io.writequeue snapshots are pending, including the one being written; write blocks if the
+ * queue is full. By default (io.writequeue = 0), snapshots are written synchronously. Copies of
+ * written snapshots are reused. An exception raised while writing in the background is rethrown
+ * by the next call to write or flush; call flush at the end of a run to report it. Errors that
+ * are still pending on destruction can only be logged.
+ *
+ * With io.format = shared, all ranks write one file per snapshot collectively through MPI-IO
+ * (see Dune::VoF::SharedSnapshot). This happens synchronously on the calling thread.
+ *
+ * With io.encoding = sparse, per rank files store only mixed cells explicitly (see
+ * Dune::VoF::ColorFunction::write). With io.compression = 1..9, value blocks of per rank files
+ * are byte shuffled and zlib compressed at that level (0 disables compression). Shared files are
+ * always dense and uncompressed, since their offsets must not depend on the data.
+ *
+ * With io.writeInterface = 1, flags, reconstructions and curvature of the written state are
+ * computed once per snapshot and appended to per rank files, so bin2vtk can skip recomputing
+ * them (see Dune::VoF::InterfaceSnapshot). Shared files cannot hold them; combining both options
+ * is an error.
+ *
+ * With io.vtk = 1, every snapshot is also written in-situ as VTU (color function, flags) and
+ * VTP (interface, curvature) with raw binary appended data, zlib compressed if io.vtkcompress
+ * is set (see Dune::VoF::VTUWriter).
+ */
 template< class GridView, class DF >
 class BinaryWriter
 {
+  using InterfaceSnapshot = Dune::VoF::InterfaceSnapshot< GridView >;
+
+  struct Snapshot
+  {
+    std::string filename;
+    double time;
+    DF values;
+    InterfaceSnapshot interface;
+  };
+
+  // operators and data to compute the interface of a snapshot
+  struct Interface
+  {
+    using Stencils = Dune::VoF::VertexNeighborsStencil< GridView >;
+    using Reconstruction = decltype( Dune::VoF::reconstruction( std::declval< Stencils & >() ) );
+    using CurvatureOperator = Dune::VoF::CartesianHeightFunctionCurvature< GridView, Stencils >;
+
+    Interface ( const GridView &gridView, double eps )
+      : stencils( gridView ), reconstruction( Dune::VoF::reconstruction( stencils ) ), flagOperator( eps ),
+        curvatureOperator( stencils, reconstruction.columns() ), flags( gridView ), reconstructions( gridView ), curvature( gridView )
+    {}
+
+    void update ( const DF &uh )
+    {
+      flagOperator( uh, flags );
+      reconstruction( uh, reconstructions, flags );
+      curvatureOperator( uh, reconstructions, flags, curvature );
+    }
+
+    void gather ( InterfaceSnapshot &snapshot ) const
+    {
+      snapshot.gather( flags.gridView(), flags, reconstructions, curvature );
+    }
+
+    Stencils stencils;
+    Reconstruction reconstruction;
+    Dune::VoF::FlagOperator< GridView > flagOperator;
+    CurvatureOperator curvatureOperator;
+    Dune::VoF::FlagSet< GridView > flags;
+    Dune::VoF::ReconstructionSet< GridView > reconstructions;
+    Dune::VoF::CurvatureSet< GridView > curvature;
+  };
+
 public:
   using BinaryStream = Dune::Fem::BinaryFileOutStream;
 
@@ -30,7 +121,73 @@ public:
     path_ = parameters.get< std::string >( "io.path", "data" );
     prefix_ = parameters.get< std::string >( "io.prefix", "vof" );
     writeData_ = parameters.get< bool >( "io.writeData", true );
+    queueSize_ = parameters.get< std::size_t >( "io.writequeue", 0 );
+    sparse_ = ( parameters.get< std::string >( "io.encoding", "dense" ) == "sparse" );
+    compression_ = parameters.get< int >( "io.compression", 0 );
+    if ( compression_ < 0 || compression_ > 9 )
+      DUNE_THROW( Dune::RangeError, "io.compression must be a zlib level 0..9, got " << compression_ );
+    storeInterface_ = parameters.get< bool >( "io.writeInterface", false );
+    if ( parameters.get< std::string >( "io.format", "rank" ) == "shared" )
+    {
+      if ( storeInterface_ )
+        DUNE_THROW( Dune::NotImplemented, "io.writeInterface is only supported for io.format = rank" );
+      sharedSnapshot_.reset( new SharedSnapshot( gridView ) );
+    }
+    if ( parameters.get< bool >( "io.vtk", false ) )
+    {
+      const bool compress = parameters.get< bool >( "io.vtkcompress", false );
+      vtuWriter_.reset( new VTUWriter( gridView, compress ) );
+      vtpWriter_.reset( new InterfaceVTPWriter( gridView, compress ) );
+    }
+    if ( storeInterface_ || vtuWriter_ )
+    {
+      interface_.reset( new Interface( gridView, parameters.get< double >( "scheme.eps", 1e-9 ) ) );
+      if ( vtuWriter_ )
+      {
+        vtuWriter_->addCellData( uh_, "celldata" );
+        vtuWriter_->addCellData( interface_->flags, "flags" );
+        vtpWriter_->addCellData( interface_->curvature, "curvature" );
+      }
+    }
     Dune::Fem::createDirectory ( path_ );
+
+    if ( queueSize_ > 0 && !sharedSnapshot_ )
+      worker_ = std::thread( [ this ] () { run(); } );
+  }
+
+  BinaryWriter ( const BinaryWriter & ) = delete;
+  BinaryWriter &operator= ( const BinaryWriter & ) = delete;
+
+  ~BinaryWriter ()
+  {
+    if ( !worker_.joinable() )
+      return;
+
+    {
+      std::lock_guard< std::mutex > lock( mutex_ );
+      finished_ = true;
+    }
+    pending_.notify_all();
+    worker_.join();
+
+    if ( !error_ )
+      return;
+    try
+    {
+      std::rethrow_exception( error_ );
+    }
+    catch ( const Dune::Exception &e )
+    {
+      std::cerr << "Error: Unable to write snapshot: " << e << std::endl;
+    }
+    catch ( const std::exception &e )
+    {
+      std::cerr << "Error: Unable to write snapshot: " << e.what() << std::endl;
+    }
+    catch ( ... )
+    {
+      std::cerr << "Error: Unable to write snapshot." << std::endl;
+    }
   }
 
   const bool willWrite ( double time )
@@ -40,8 +197,31 @@ public:
 
   const void write ( double time, const bool forced = false )
   {
+    rethrow();
 
-    if ( willWrite( time ) || forced )
+    if ( !willWrite( time ) && !forced )
+      return;
+
+    if ( interface_ )
+      interface_->update( uh_ );
+
+    if ( vtuWriter_ )
+    {
+      std::stringstream name;
+      name.fill('0');
+      name << prefix_ << "-" << std::to_string( level_ ) << "-" << std::setw(5) << std::to_string( writeStep_ );
+      vtuWriter_->write( path_, name.str() );
+      vtpWriter_->write( path_, name.str(), interface_->reconstructions, interface_->flags );
+    }
+
+    if ( sharedSnapshot_ )
+    {
+      std::stringstream name;
+      name.fill('0');
+      name << prefix_ << "-" << std::to_string( level_ ) << "-" << std::setw(5) << std::to_string( writeStep_ ) << ".bin";
+      sharedSnapshot_->write( Dune::concatPaths( path_, name.str() ), time, uh_ );
+    }
+    else
     {
       std::stringstream name;
       name.fill('0');
@@ -50,23 +230,171 @@ public:
 
       std::stringstream dfname;
       dfname << name.str() << ".bin";
-      BinaryStream binaryStream ( Dune::concatPaths( path_, dfname.str() ) );
-      binaryStream << time;
-      uh_.write( binaryStream );
 
-      saveTime_ += saveStep_;
-      writeStep_++;
+      if ( queueSize_ == 0 )
+      {
+        InterfaceSnapshot interface;
+        if ( storeInterface_ )
+          interface_->gather( interface );
+
+        BinaryStream binaryStream ( Dune::concatPaths( path_, dfname.str() ) );
+        binaryStream << time;
+        uh_.write( binaryStream, sparse_, compression_ );
+        writeInterface( binaryStream, interface );
+      }
+      else
+        push( Dune::concatPaths( path_, dfname.str() ), time );
     }
+
+    saveTime_ += saveStep_;
+    writeStep_++;
+  }
+
+  int compression () const { return compression_; }
+
+  /**
+   * \brief write counters, so a restarted run continues the snapshot series
+   */
+  template< class Stream >
+  void writeState ( Stream &stream ) const
+  {
+    stream << saveTime_;
+    stream.writeUnsignedInt64( writeStep_ );
+  }
+
+  template< class Stream >
+  void readState ( Stream &stream )
+  {
+    std::uint64_t writeStep;
+    stream >> saveTime_;
+    stream.readUnsignedInt64( writeStep );
+    writeStep_ = writeStep;
+  }
+
+  /**
+   * \brief block until all pending snapshots are written
+   */
+  void flush ()
+  {
+    {
+      std::unique_lock< std::mutex > lock( mutex_ );
+      written_.wait( lock, [ this ] () { return queue_.empty() && !busy_; } );
+    }
+    rethrow();
   }
 
 private:
+  // rethrow an exception raised by the worker thread
+  void rethrow ()
+  {
+    std::exception_ptr error;
+    {
+      std::lock_guard< std::mutex > lock( mutex_ );
+      std::swap( error, error_ );
+    }
+    if ( error )
+      std::rethrow_exception( error );
+  }
+
+  void push ( std::string filename, double time )
+  {
+    std::vector< DF > buffer;
+    {
+      std::unique_lock< std::mutex > lock( mutex_ );
+      written_.wait( lock, [ this ] () { return queue_.size() + (busy_ ? 1 : 0) < queueSize_; } );
+      if ( !free_.empty() )
+      {
+        buffer.push_back( std::move( free_.back() ) );
+        free_.pop_back();
+      }
+    }
+
+    // reuse the storage of a written snapshot if available
+    if ( buffer.empty() )
+      buffer.push_back( uh_ );
+    else
+      buffer.front() = uh_;
+    Snapshot snapshot{ std::move( filename ), time, std::move( buffer.front() ) };
+    if ( storeInterface_ )
+      interface_->gather( snapshot.interface );
+
+    {
+      std::lock_guard< std::mutex > lock( mutex_ );
+      queue_.push_back( std::move( snapshot ) );
+    }
+    pending_.notify_one();
+  }
+
+  void writeInterface ( BinaryStream &binaryStream, const InterfaceSnapshot &interface ) const
+  {
+    binaryStream.writeBool( storeInterface_ );
+    if ( storeInterface_ )
+      interface.write( binaryStream );
+  }
+
+  void run ()
+  {
+    std::unique_lock< std::mutex > lock( mutex_ );
+    while ( true )
+    {
+      pending_.wait( lock, [ this ] () { return finished_ || !queue_.empty(); } );
+      if ( queue_.empty() )
+        return;
+
+      Snapshot snapshot = std::move( queue_.front() );
+      queue_.pop_front();
+      busy_ = true;
+      lock.unlock();
+
+      std::exception_ptr error;
+      try
+      {
+        BinaryStream binaryStream ( snapshot.filename );
+        binaryStream << snapshot.time;
+        snapshot.values.write( binaryStream, sparse_, compression_ );
+        writeInterface( binaryStream, snapshot.interface );
+      }
+      catch ( ... )
+      {
+        error = std::current_exception();
+      }
+
+      lock.lock();
+      if ( error && !error_ )
+        error_ = error;
+      busy_ = false;
+      free_.push_back( std::move( snapshot.values ) );
+      written_.notify_all();
+    }
+  }
+
   const GridView& gridView_;
   const DF &uh_;
   std::string path_, prefix_;
   const std::size_t level_;
   double saveStep_, saveTime_ ;
   std::size_t writeStep_ = 0;
-  bool writeData_;
+  bool writeData_, sparse_;
+  int compression_;
+
+  using SharedSnapshot = Dune::VoF::SharedSnapshot< GridView >;
+  std::unique_ptr< SharedSnapshot > sharedSnapshot_;
+  std::unique_ptr< Interface > interface_;
+  bool storeInterface_ = false;
+
+  using VTUWriter = Dune::VoF::VTUWriter< GridView >;
+  using InterfaceVTPWriter = Dune::VoF::InterfaceVTPWriter< GridView >;
+  std::unique_ptr< VTUWriter > vtuWriter_;
+  std::unique_ptr< InterfaceVTPWriter > vtpWriter_;
+
+  std::size_t queueSize_;
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable pending_, written_;
+  std::deque< Snapshot > queue_;
+  std::vector< DF > free_;
+  bool busy_ = false, finished_ = false;
+  std::exception_ptr error_;
 };
 
 #endif
@@ -0,0 +1,131 @@
+#ifndef CHECKPOINT_HH
+#define CHECKPOINT_HH
+
+// C++ includes
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+// dune-common includes
+#include <dune/common/exceptions.hh>
+#include <dune/common/parametertree.hh>
+#include <dune/common/path.hh>
+
+// dune-fem includes
+#include <dune/fem/io/io.hh>
+#include <dune/fem/io/streams/binarystreams.hh>
+
+
+// Checkpointer
+// ============
+/*
+ * Writes the color function, the state of the time iteration (time, next time step, accumulated
+ * error) and the counters of the data writer every io.checkpointinterval seconds of wall clock
+ * time (0 disables checkpointing). Rank 0 measures the time and broadcasts the decision, so all
+ * ranks checkpoint in the same step. Pending snapshots of the data writer are flushed first, so
+ * the stored counters never refer to a snapshot that is not on disk yet; if writing a snapshot
+ * failed on any rank, the checkpoint fails on all of them. Each rank writes one file, first to a
+ * temporary name that is renamed once all ranks have completed theirs, so an interrupted
+ * checkpoint never replaces the last valid one. A crash between the renames of different ranks leaves checkpoints of
+ * different steps; reading them raises an error instead of restarting inconsistently.
+ *
+ * The color function is compressed at the level of the data writer (io.compression).
+ *
+ * Flags and reconstructions are not stored: the next step recomputes them from the color
+ * function before using them, so restoring them would not change the result.
+ */
+template< class GridView, class DF, class DataWriter, class State >
+class Checkpointer
+{
+public:
+  Checkpointer ( const GridView &gridView, const DF &uh, DataWriter &dataWriter, const Dune::ParameterTree &parameters, int level )
+    : gridView_( gridView ), uh_( uh ), dataWriter_( dataWriter ),
+      interval_( parameters.get< double >( "io.checkpointinterval", 0.0 ) ),
+      last_( std::chrono::steady_clock::now() )
+  {
+    const std::string path = parameters.get< std::string >( "io.path", "data" );
+    Dune::Fem::createDirectory( path );
+
+    std::stringstream name;
+    name.fill('0');
+    name << "s" << std::setw(4) << gridView.comm().size() << "-p" << std::setw(4) << gridView.comm().rank()
+      << "-" << parameters.get< std::string >( "io.prefix", "vof" ) << "-" << std::to_string( level ) << "-checkpoint.bin";
+    filename_ = Dune::concatPaths( path, name.str() );
+  }
+
+  const std::string &filename () const { return filename_; }
+
+  bool enabled () const { return interval_ > 0.0; }
+
+  void operator() ( const State &state )
+  {
+    if ( !enabled() )
+      return;
+
+    int due = ( std::chrono::duration< double >( std::chrono::steady_clock::now() - last_ ).count() >= interval_ );
+    gridView_.comm().broadcast( &due, 1, 0 );
+    if ( !due )
+      return;
+
+    write( state );
+    last_ = std::chrono::steady_clock::now();
+  }
+
+  void write ( const State &state ) const
+  {
+    std::exception_ptr error;
+    try
+    {
+      dataWriter_.flush();
+    }
+    catch ( ... )
+    {
+      error = std::current_exception();
+    }
+    if ( gridView_.comm().max( static_cast< int >( static_cast< bool >( error ) ) ) )
+    {
+      if ( error )
+        std::rethrow_exception( error );
+      DUNE_THROW( Dune::IOError, "Unable to write checkpoint " << filename_ << ": writing a snapshot failed on another rank" );
+    }
+
+    const std::string temporary = filename_ + ".tmp";
+    {
+      Dune::Fem::BinaryFileOutStream stream( temporary );
+      stream << state.time << state.dt << state.error;
+      dataWriter_.writeState( stream );
+      uh_.write( stream, false, dataWriter_.compression() );
+    }
+    gridView_.comm().barrier();
+    if ( std::rename( temporary.c_str(), filename_.c_str() ) != 0 )
+      DUNE_THROW( Dune::IOError, "Unable to write checkpoint " << filename_ );
+  }
+
+  /**
+   * \brief restore color function, iteration state and writer counters
+   */
+  static void read ( const std::string &filename, DF &uh, DataWriter &dataWriter, State &state )
+  {
+    Dune::Fem::BinaryFileInStream stream( filename );
+    stream >> state.time >> state.dt >> state.error;
+    dataWriter.readState( stream );
+    uh.read( stream );
+
+    const auto &comm = uh.gridView().comm();
+    if ( comm.min( state.time ) != comm.max( state.time ) )
+      DUNE_THROW( Dune::IOError, "Checkpoints " << filename << " of different ranks belong to different time steps" );
+  }
+
+private:
+  const GridView &gridView_;
+  const DF &uh_;
+  DataWriter &dataWriter_;
+  double interval_;
+  std::chrono::steady_clock::time_point last_;
+  std::string filename_;
+};
+
+#endif
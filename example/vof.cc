@@ -26,12 +26,48 @@
 #include "../dune/vof/test/problems/sflow.hh"
 #include "../dune/vof/test/problems/slottedcylinder.hh"
 #include <dune/vof/algorithm.hh>
+#include <dune/vof/io/sharedsnapshot.hh>
 
 #include "binarywriter.hh"
+#include "checkpoint.hh"
+
+// FunneledMPI
+// -----------
+
+// Initializes MPI such that worker threads may exist while only the main thread communicates.
+// If MPI does not grant this level, funneled() is false and the scheme must run single threaded.
+// Dune::MPIHelper, created afterwards, finds MPI initialized and leaves finalizing it to us.
+struct FunneledMPI
+{
+  FunneledMPI ( int &argc, char **&argv )
+  {
+#if HAVE_MPI
+    int provided;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_FUNNELED, &provided );
+    funneled_ = ( provided >= MPI_THREAD_FUNNELED );
+#endif
+  }
+
+  ~FunneledMPI ()
+  {
+#if HAVE_MPI
+    int finalized;
+    MPI_Finalized( &finalized );
+    if ( !finalized )
+      MPI_Finalize();
+#endif
+  }
+
+  bool funneled () const { return funneled_; }
+
+private:
+  bool funneled_ = true;
+};
 
 int main(int argc, char** argv)
 try {
 
+  FunneledMPI funneledMPI( argc, argv );
   Dune::MPIHelper::instance( argc, argv );
 
   // Read Parameter File
@@ -46,8 +82,18 @@ try {
   double end = parameters.get< double >( "scheme.end", 2.5 );
   double cfl = parameters.get< double >( "scheme.cfl", 1.0 );
   double eps = parameters.get< double >( "scheme.eps", 1e-9 );
+  std::string timeStep = parameters.get< std::string >( "scheme.timestep", "global" );
+  std::size_t threads = parameters.get< std::size_t >( "scheme.threads", 1 );
+  if ( threads > 1 && !funneledMPI.funneled() )
+  {
+    std::cerr << "Warning: MPI does not support MPI_THREAD_FUNNELED, using a single thread." << std::endl;
+    threads = 1;
+  }
   std::string path = parameters.get< std::string >( "io.path", "data" );
   int restartStep = parameters.get< int >( "io.restartStep", -1 );
+  bool restartCheckpoint = parameters.get< bool >( "io.restartCheckpoint", false );
+  std::string format = parameters.get< std::string >( "io.format", "rank" );
+  std::string prefix = parameters.get< std::string >( "io.prefix", "vof" );
   int verboserank = parameters.get< int >( "io.verboserank", -1 );
 
   using Grid = Dune::GridSelector::GridType;
@@ -85,12 +131,29 @@ try {
     ColorFunction uh( gridView );
 
 
-    if ( restartStep == -1 )
+    if ( restartStep == -1 || restartCheckpoint )
     {
       // Use initial data of problem.
       Dune::VoF::Average< ProblemType > average ( problem );
       average( uh, start, ( gridView.comm().rank() == 0 && level == level0 ) );
     }
+    else if ( format == "shared" )
+    {
+      // Use given data in shared binary file, possibly written on a different number of ranks.
+      std::stringstream namedata;
+      namedata.fill('0');
+      namedata << prefix << "-" << std::to_string( level ) << "-" << std::setw(5) << restartStep << ".bin";
+      const auto filename = Dune::concatPaths( path, namedata.str() );
+      if ( !Dune::Fem::fileExists( filename ) )
+      {
+        std::cout << "Restart error: A time step is given to load binary file but this file does not exist." << std::endl;
+        return 1;
+      }
+      Dune::VoF::SharedSnapshot< GridView > snapshot( gridView );
+      start = snapshot.read( filename, uh );
+      if ( grid.comm().rank() == 0 )
+        std::cout << "Restarted in file " << filename << std::endl;
+    }
     else
     {
       // Use given data in binary file.
@@ -122,10 +185,37 @@ try {
     using DataOutputType = BinaryWriter< GridView, ColorFunction >;
     DataOutputType dataOutput( gridView, uh, parameters, level );
 
+    // Time step control
+    using AlgorithmType = Dune::VoF::Algorithm< GridView, ProblemType, DataOutputType >;
+    using TimeStepControl = AlgorithmType::TimeStepControlType;
+    const auto mode = TimeStepControl::parseMode( timeStep );
+    const double fixedEstimate = ( mode == TimeStepControl::Mode::fixed ? Dune::VoF::velocityBoundEstimate( gridView, problem.maxVelocity() ) : 0.0 );
+    TimeStepControl timeStepControl( gridView.comm(), mode, fixedEstimate );
+
     // Run Algorithm
-    Dune::VoF::Algorithm< GridView, ProblemType, DataOutputType > algorithm( gridView, problem, dataOutput, cfl, eps, verbose );
+    AlgorithmType algorithm( gridView, problem, dataOutput, cfl, eps, timeStepControl, verbose, threads );
+
+    // Checkpoints
+    using State = AlgorithmType::State;
+    using CheckpointerType = Checkpointer< GridView, ColorFunction, DataOutputType, State >;
+    CheckpointerType checkpointer( gridView, uh, dataOutput, parameters, level );
+    algorithm.checkpoint( [ &checkpointer ] ( const State &state ) { checkpointer( state ); } );
+
+    State state;
+    state.time = start;
+    if ( restartCheckpoint )
+    {
+      if ( !Dune::Fem::fileExists( checkpointer.filename() ) )
+      {
+        std::cout << "Restart error: Checkpoint file " << checkpointer.filename() << " does not exist." << std::endl;
+        return 1;
+      }
+      CheckpointerType::read( checkpointer.filename(), uh, dataOutput, state );
+      if ( grid.comm().rank() == 0 )
+        std::cout << "Restarted from checkpoint at time " << state.time << std::endl;
+    }
 
-    double partError = algorithm( uh, start, end, level );
+    double partError = algorithm( uh, state, end, level );
     double error = grid.comm().sum( partError );
 
     if ( grid.comm().rank() == 0 )
@@ -138,7 +228,9 @@ try {
 }
 catch ( Dune::Exception &e ) {
   std::cerr << "Dune reported error: " << e << std::endl;
+  return 1;
 }
 catch (...) {
   std::cerr << "Unknown exception thrown!" << std::endl;
+  return 1;
 }